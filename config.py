@@ -79,6 +79,10 @@ class configuration:
   # Compile with PAPI instrumentation
   with_papi = False
 
+  # Compile with per-thread counters of the work, FSR lock contention and
+  # hardware events in the transport sweeps of the CPUSolver classes
+  with_counters = False
+
   # Compile with NumPy typemaps and the C API to allow users to pass NumPy
   # arrays to/from the C++ source code
   with_numpy = True
@@ -120,6 +124,7 @@ class configuration:
   sources['gcc'] = ['openmoc/openmoc_wrap.cpp',
                     'src/Cell.cpp',
                     'src/Geometry.cpp',
+                    'src/CompiledGeometry.cpp',
                     'src/LocalCoords.cpp',
                     'src/log.cpp',
                     'src/Material.cpp',
@@ -127,6 +132,7 @@ class configuration:
                     'src/Quadrature.cpp',
                     'src/Solver.cpp',
                     'src/CPUSolver.cpp',
+                    'src/BatchedSolver.cpp',
                     'src/Surface.cpp',
                     'src/Timer.cpp',
                     'src/Track.cpp',
@@ -137,6 +143,7 @@ class configuration:
   sources['icpc'] = ['openmoc/openmoc_wrap.cpp',
                      'src/Cell.cpp',
                      'src/Geometry.cpp',
+                     'src/CompiledGeometry.cpp',
                      'src/LocalCoords.cpp',
                      'src/log.cpp',
                      'src/Material.cpp',
@@ -144,6 +151,7 @@ class configuration:
                      'src/Quadrature.cpp',
                      'src/Solver.cpp',
                      'src/CPUSolver.cpp',
+                     'src/BatchedSolver.cpp',
                      'src/VectorizedSolver.cpp',
                      'src/Surface.cpp',
                      'src/Timer.cpp',
@@ -155,6 +163,7 @@ class configuration:
   sources['bgxlc'] = ['openmoc/openmoc_wrap.cpp',
                       'src/Cell.cpp',
                       'src/Geometry.cpp',
+                      'src/CompiledGeometry.cpp',
                       'src/LocalCoords.cpp',
                       'src/log.cpp',
                       'src/Material.cpp',
@@ -162,6 +171,7 @@ class configuration:
                       'src/Quadrature.cpp',
                       'src/Solver.cpp',
                       'src/CPUSolver.cpp',
+                      'src/BatchedSolver.cpp',
                       'src/Surface.cpp',
                       'src/Timer.cpp',
                       'src/Track.cpp',
@@ -355,6 +365,13 @@ class configuration:
       for k in self.compiler_flags:
         self.compiler_flags[k].append('-g')
 
+    # If the user wishes to count the work in the transport sweeps, define
+    # the SWEEP_COUNTERS macro for all C++ compilers
+    if self.with_counters:
+      for cc in ['gcc', 'icpc', 'bgxlc']:
+        for fp in self.macros[cc]:
+          self.macros[cc][fp].append(('SWEEP_COUNTERS', None))
+
     # If the user passed in the --no-numpy flag, tell SWIG not to embed
     # NumPy typemaps in the source code
     if not self.with_numpy:
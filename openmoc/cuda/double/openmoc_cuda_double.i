@@ -48,6 +48,11 @@
  * openmoc.process */
 %apply (double* ARGOUT_ARRAY1, int DIM1) {(double* fission_rates, int num_FSRs)}
 
+/* The typemap used to match the method signature for the Solver's
+ * getTelemetry method to retrieve the quantities recorded for each source
+ * iteration */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* telemetry, int num_records)}
+
 #endif
 
 
@@ -15,6 +15,7 @@
   #include "../src/Quadrature.h"
   #include "../src/Solver.h"
   #include "../src/CPUSolver.h"
+  #include "../src/BatchedSolver.h"
   #include "../src/Surface.h"
   #include "../src/Timer.h"
   #include "../src/Track.h" 
@@ -284,6 +285,17 @@
  * openmoc.process */
 %apply (double* ARGOUT_ARRAY1, int DIM1) {(double* fission_rates, int num_FSRs)}
 
+/* The typemap used to match the method signature for the Solver's
+ * getTelemetry method to retrieve the quantities recorded for each source
+ * iteration */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* telemetry, int num_records)}
+
+/* The typemaps used to match the method signatures for the CPUSolver's
+ * getSweepCounter and getTrackTimeHistogram methods to retrieve the
+ * transport sweep counters of a build with --with-counters */
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* counts, int num_threads)}
+%apply (double* ARGOUT_ARRAY1, int DIM1) {(double* histogram, int num_bins)}
+
 /* The typemap used to match the method signature for the Universe's
  * getCellIds method for the data processing routines in openmoc.process */
 %apply (int* ARGOUT_ARRAY1, int DIM1) {(int* cell_ids, int num_cells)}
@@ -301,6 +313,7 @@
 %include ../src/Quadrature.h
 %include ../src/Solver.h
 %include ../src/CPUSolver.h
+%include ../src/BatchedSolver.h
 %include ../src/Surface.h
 %include ../src/Timer.h
 %include ../src/Track.h
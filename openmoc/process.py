@@ -556,3 +556,42 @@ def restore_simulation_state(filename='simulation-state.h5',
               '*.h5, *.hdf5, and *.pkl files are supported', filename)
 
     return {}
+
+
+
+##
+# @brief This routine retrieves the Timer's splits as nested dictionaries.
+# @details Each split is a dictionary with its 'time' (seconds) and 'count'
+#          and a 'splits' dictionary of the splits nested within it, indexed
+#          by name. The outer splits are indexed by name in the dictionary
+#          which is returned. This may be used to compare the startup and
+#          solve times of different runs, and may be called from a Python
+#          script as follows:
+#
+# @code
+#          splits = get_timer_splits(openmoc.Timer)
+#          sweep = splits['Total time to converge the source']['splits'] \
+#                        ['Transport sweep']['time']
+# @endcode
+#
+# @param timer the OpenMOC Timer
+# @return a dictionary of the outer splits indexed by name
+def get_timer_splits(timer):
+
+    splits = {}
+
+    for i in range(timer.getNumSplits()):
+
+        path = timer.getSplitPath(i)
+        names = path.split('/')
+
+        # Find the dictionary of the splits nested within the split's parent
+        parent = splits
+        for name in names[:-1]:
+            parent = parent.setdefault(name, {'splits' : {}})['splits']
+
+        split = parent.setdefault(names[-1], {'splits' : {}})
+        split['time'] = timer.getSplit(path)
+        split['count'] = timer.getSplitCount(path)
+
+    return splits
@@ -0,0 +1,411 @@
+# This script checks that storing the Track boundary angular fluxes in
+# single precision does not change the solution of the OECD's C5G7 benchmark
+# problem. The problem is the same as in c5g7.py. It is solved once with the
+# CPUSolver's default boundary flux storage and once with
+# setBoundaryFluxSinglePrecision(True), and the eigenvalues and FSR fission
+# rates are compared, for example with:
+#
+#   python c5g7-single-boundary-flux.py -t 1 -a 4 -s 0.1 -c 1e-5
+#
+# The comparison passes if k_eff differs by less than KEFF_TOLERANCE (1 pcm)
+# and the fission rate in every fissionable FSR differs by less than
+# FISSION_RATE_TOLERANCE relative to the default solve. With the options
+# above in a double precision build, both solves take 703 transport sweeps
+# to a k_eff of 1.18534775, and the fission rates differ by at most 6.5E-9.
+
+from openmoc import *
+import numpy
+import openmoc.log as log
+import openmoc.materialize as materialize
+from openmoc.options import Options
+
+
+###############################################################################
+#######################   Main Simulation Parameters   ########################
+###############################################################################
+
+options = Options()
+
+num_threads = options.getNumThreads()
+track_spacing = options.getTrackSpacing()
+num_azim = options.getNumAzimAngles()
+tolerance = options.getTolerance()
+max_iters = options.getMaxIterations()
+
+log.set_log_level('NORMAL')
+
+log.py_printf('TITLE', 'Comparing Single Precision Boundary Fluxes for ' + \
+                       'the C5G7 Benchmark Problem...')
+
+
+###############################################################################
+###########################   Creating Materials   ############################
+###############################################################################
+
+log.py_printf('NORMAL', 'Importing materials data from HDF5...')
+
+materials = materialize.materialize('../../c5g7-materials.h5')
+
+uo2_id = materials['UO2'].getId()
+mox43_id = materials['MOX-4.3%'].getId()
+mox7_id = materials['MOX-7%'].getId()
+mox87_id = materials['MOX-8.7%'].getId()
+guide_tube_id = materials['Guide Tube'].getId()
+fiss_id = materials['Fission Chamber'].getId()
+water_id = materials['Water'].getId()
+
+
+###############################################################################
+###########################   Creating Surfaces   #############################
+###############################################################################
+
+log.py_printf('NORMAL', 'Creating surfaces...')
+
+circles = []
+planes = []
+planes.append(XPlane(x=-32.13))
+planes.append(XPlane(x=32.13))
+planes.append(YPlane(y=-32.13))
+planes.append(YPlane(y=32.13))
+circles.append(Circle(x=0., y=0., radius=0.54))
+circles.append(Circle(x=0., y=0., radius=0.58))
+circles.append(Circle(x=0., y=0., radius=0.62))
+planes[0].setBoundaryType(REFLECTIVE)
+planes[1].setBoundaryType(VACUUM)
+planes[2].setBoundaryType(VACUUM)
+planes[3].setBoundaryType(REFLECTIVE)
+
+
+###############################################################################
+#############################   Creating Cells   ##############################
+###############################################################################
+
+log.py_printf('NORMAL', 'Creating cells...')
+
+cells = []
+
+# UO2 pin cells
+cells.append(CellBasic(universe=1, material=uo2_id, rings=3, sectors=8))
+cells.append(CellBasic(universe=1, material=water_id, sectors=8))
+cells.append(CellBasic(universe=1, material=water_id, sectors=8))
+cells.append(CellBasic(universe=1, material=water_id, sectors=8))
+cells[0].addSurface(-1, circles[0])
+cells[1].addSurface(+1, circles[0])
+cells[1].addSurface(-1, circles[1])
+cells[2].addSurface(+1, circles[1])
+cells[2].addSurface(-1, circles[2])
+cells[3].addSurface(+1, circles[2])
+
+
+# 4.3% MOX pin cells
+cells.append(CellBasic(universe=2, material=mox43_id, rings=3, sectors=8))
+cells.append(CellBasic(universe=2, material=water_id, sectors=8))
+cells.append(CellBasic(universe=2, material=water_id, sectors=8))
+cells.append(CellBasic(universe=2, material=water_id, sectors=8))
+cells[4].addSurface(-1, circles[0])
+cells[5].addSurface(+1, circles[0])
+cells[5].addSurface(-1, circles[1])
+cells[6].addSurface(+1, circles[1])
+cells[6].addSurface(-1, circles[2])
+cells[7].addSurface(+1, circles[2])
+
+
+# 7% MOX pin cells
+cells.append(CellBasic(universe=3, material=mox7_id, rings=3, sectors=8))
+cells.append(CellBasic(universe=3, material=water_id, sectors=8))
+cells.append(CellBasic(universe=3, material=water_id, sectors=8))
+cells.append(CellBasic(universe=3, material=water_id, sectors=8))
+cells[8].addSurface(-1, circles[0])
+cells[9].addSurface(+1, circles[0])
+cells[9].addSurface(-1, circles[1])
+cells[10].addSurface(+1, circles[1])
+cells[10].addSurface(-1, circles[2])
+cells[11].addSurface(+1, circles[2])
+
+
+# 8.7% MOX pin cells
+cells.append(CellBasic(universe=4, material=mox87_id, rings=3, sectors=8))
+cells.append(CellBasic(universe=4, material=water_id, sectors=8))
+cells.append(CellBasic(universe=4, material=water_id, sectors=8))
+cells.append(CellBasic(universe=4, material=water_id, sectors=8))
+cells[12].addSurface(-1, circles[0])
+cells[13].addSurface(+1, circles[0])
+cells[13].addSurface(-1, circles[1])
+cells[14].addSurface(+1, circles[1])
+cells[14].addSurface(-1, circles[2])
+cells[15].addSurface(+1, circles[2])
+
+# Fission chamber pin cells
+cells.append(CellBasic(universe=5, material=fiss_id, rings=3, sectors=8))
+cells.append(CellBasic(universe=5, material=water_id, sectors=8))
+cells.append(CellBasic(universe=5, material=water_id, sectors=8))
+cells.append(CellBasic(universe=5, material=water_id, sectors=8))
+cells[16].addSurface(-1, circles[0])
+cells[17].addSurface(+1, circles[0])
+cells[17].addSurface(-1, circles[1])
+cells[18].addSurface(+1, circles[1])
+cells[18].addSurface(-1, circles[2])
+cells[19].addSurface(+1, circles[2])
+
+# Guide tube pin cells
+cells.append(CellBasic(universe=6, material=guide_tube_id, rings=3, sectors=8))
+cells.append(CellBasic(universe=6, material=water_id, sectors=8))
+cells.append(CellBasic(universe=6, material=water_id, sectors=8))
+cells.append(CellBasic(universe=6, material=water_id, sectors=8))
+cells[20].addSurface(-1, circles[0])
+cells[21].addSurface(+1, circles[0])
+cells[21].addSurface(-1, circles[1])
+cells[22].addSurface(+1, circles[1])
+cells[22].addSurface(-1, circles[2])
+cells[23].addSurface(+1, circles[2])
+
+# Moderator cell
+cells.append(CellBasic(universe=7, material=water_id))
+
+# Top left, bottom right lattice
+cells.append(CellFill(universe=10, universe_fill=20))
+
+# Top right, bottom left lattice
+cells.append(CellFill(universe=11, universe_fill=21))
+
+# Moderator lattice - semi-finely spaced
+cells.append(CellFill(universe=12, universe_fill=23))
+
+# Moderator lattice - bottom of geometry
+cells.append(CellFill(universe=13, universe_fill=24))
+
+# Moderator lattice - bottom corner of geometry
+cells.append(CellFill(universe=14, universe_fill=25))
+
+# Moderator lattice right side of geometry
+cells.append(CellFill(universe=15, universe_fill=26))
+
+# Full geometry
+cells.append(CellFill(universe=0, universe_fill=30))
+cells[-1].addSurface(+1, planes[0])
+cells[-1].addSurface(-1, planes[1])
+cells[-1].addSurface(+1, planes[2])
+cells[-1].addSurface(-1, planes[3])
+
+
+###############################################################################
+###########################   Creating Lattices   #############################
+###############################################################################
+
+log.py_printf('NORMAL', 'Creating lattices...')
+
+lattices = []
+
+# Top left, bottom right 17 x 17 assemblies
+lattices.append(Lattice(id=20, width_x=1.26, width_y=1.26))
+lattices[-1].setLatticeCells(
+    [[1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 1, 1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1, 1, 1, 1],
+     [1, 1, 1, 6, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 1, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 6, 1, 1, 6, 1, 1, 5, 1, 1, 6, 1, 1, 6, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 1, 6, 1, 1, 1, 1, 1, 1, 1, 1, 1, 6, 1, 1, 1],
+     [1, 1, 1, 1, 1, 6, 1, 1, 6, 1, 1, 6, 1, 1, 1, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1],
+     [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1]])
+
+
+# Top right, bottom left 17 x 17 assemblies 
+lattices.append(Lattice(id=21, width_x=1.26, width_y=1.26))
+lattices[-1].setLatticeCells(
+    [[2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2],
+     [2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2],
+     [2, 3, 3, 3, 3, 6, 3, 3, 6, 3, 3, 6, 3, 3, 3, 3, 2],
+     [2, 3, 3, 6, 3, 4, 4, 4, 4, 4, 4, 4, 3, 6, 3, 3, 2],
+     [2, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 2],
+     [2, 3, 6, 4, 4, 6, 4, 4, 6, 4, 4, 6, 4, 4, 6, 3, 2],
+     [2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 2],
+     [2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 2],
+     [2, 3, 6, 4, 4, 6, 4, 4, 5, 4, 4, 6, 4, 4, 6, 3, 2],
+     [2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 2],
+     [2, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 2],
+     [2, 3, 6, 4, 4, 6, 4, 4, 6, 4, 4, 6, 4, 4, 6, 3, 2],
+     [2, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 3, 3, 2],
+     [2, 3, 3, 6, 3, 4, 4, 4, 4, 4, 4, 4, 3, 6, 3, 3, 2],
+     [2, 3, 3, 3, 3, 6, 3, 3, 6, 3, 3, 6, 3, 3, 3, 3, 2],
+     [2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2],
+     [2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2]])
+
+
+# Sliced up water cells - semi finely spaced
+lattices.append(Lattice(id=23, width_x=0.126, width_y=0.126))
+lattices[-1].setLatticeCells(
+    [[7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7]])
+
+
+# Sliced up water cells - right side of geometry
+lattices.append(Lattice(id=26, width_x=1.26, width_y=1.26))
+lattices[-1].setLatticeCells(
+    [[12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7]])
+
+
+# Sliced up water cells for bottom corner of geometry
+lattices.append(Lattice(id=25, width_x=1.26, width_y=1.26))
+lattices[-1].setLatticeCells(
+    [[12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7]])
+
+
+# Sliced up water cells for bottom of geometry
+lattices.append(Lattice(id=24, width_x=1.26, width_y=1.26))
+lattices[-1].setLatticeCells(
+    [[12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7],
+     [7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7]])
+
+
+# 4 x 4 core to represent two bundles and water
+lattices.append(Lattice(id=30, width_x=21.42, width_y=21.42))
+lattices[-1].setLatticeCells([[10, 11, 15],
+                             [11, 10, 15],
+                             [13, 13, 14]])
+
+
+###############################################################################
+##########################   Creating the Geometry   ##########################
+###############################################################################
+
+log.py_printf('NORMAL', 'Creating geometry...')
+
+geometry = Geometry()
+
+for material in materials.values(): geometry.addMaterial(material)
+for cell in cells: geometry.addCell(cell)
+for lattice in lattices: geometry.addLattice(lattice)
+
+geometry.initializeFlatSourceRegions()
+
+
+###############################################################################
+########################   Creating the TrackGenerator   ######################
+###############################################################################
+
+log.py_printf('NORMAL', 'Initializing the track generator...')
+
+track_generator = TrackGenerator(geometry, num_azim, track_spacing)
+track_generator.generateTracks()
+
+
+###############################################################################
+####################   Comparing the Boundary Flux Storage   ##################
+###############################################################################
+
+# The largest accepted absolute difference in k_eff
+KEFF_TOLERANCE = 1E-5
+
+# The largest accepted relative difference in any FSR fission rate
+FISSION_RATE_TOLERANCE = 1E-4
+
+num_FSRs = geometry.getNumFSRs()
+
+log.py_printf('NORMAL', 'Solving with the default boundary fluxes...')
+
+solver = CPUSolver(geometry, track_generator)
+solver.setSourceConvergenceThreshold(tolerance)
+solver.setNumThreads(num_threads)
+solver.convergeSource(max_iters)
+
+keff = solver.getKeff()
+fission_rates = solver.computeFSRFissionRates(num_FSRs)
+
+log.py_printf('NORMAL', 'Solving with single precision boundary fluxes...')
+
+solver = CPUSolver(geometry, track_generator)
+solver.setSourceConvergenceThreshold(tolerance)
+solver.setNumThreads(num_threads)
+solver.setBoundaryFluxSinglePrecision(True)
+solver.convergeSource(max_iters)
+
+single_keff = solver.getKeff()
+single_fission_rates = solver.computeFSRFissionRates(num_FSRs)
+
+# Compare the fission rates in the fissionable FSRs only
+fissionable = fission_rates > 0.
+keff_error = abs(single_keff - keff)
+fission_rate_errors = abs(single_fission_rates[fissionable] - \
+                          fission_rates[fissionable]) / \
+                      fission_rates[fissionable]
+
+passed = keff_error < KEFF_TOLERANCE and \
+         fission_rate_errors.max() < FISSION_RATE_TOLERANCE
+
+log.py_printf('RESULT', 'Default k_eff: %1.8f', keff)
+log.py_printf('RESULT', 'Single precision k_eff: %1.8f', single_keff)
+log.py_printf('RESULT', 'k_eff difference: %1.2E (tolerance %1.2E)', \
+              keff_error, KEFF_TOLERANCE)
+log.py_printf('RESULT', 'Max fission rate relative difference: %1.2E ' + \
+              '(tolerance %1.2E)', fission_rate_errors.max(), \
+              FISSION_RATE_TOLERANCE)
+log.py_printf('RESULT', 'Mean fission rate relative difference: %1.2E', \
+              numpy.mean(fission_rate_errors))
+log.py_printf('RESULT', 'Single precision boundary fluxes: %s', \
+              'PASSED' if passed else 'FAILED')
+
+log.py_printf('TITLE', 'Finished')
@@ -48,6 +48,7 @@ class custom_install(install):
     ('debug-mode', None, "Build with debugging symbols"),
     ('with-ccache', None, "Build with ccache for rapid recompilation"),
     ('with-papi', None, 'Build modules with PAPI instrumentation'),
+    ('with-counters', None, 'Build modules with transport sweep counters'),
     ('no-numpy', None, 'Build modules without NumPy C API')
   ]
 
@@ -65,6 +66,7 @@ class custom_install(install):
                      'debug-mode',
                      'with-ccache',
                      'with-papi',
+                     'with-counters',
                      'no-numpy']
 
   # Include all of the boolean options provided by distutils for the
@@ -104,6 +106,7 @@ class custom_install(install):
     self.debug_mode = False
     self.with_ccache = False
     self.with_papi = False
+    self.with_counters = False
     self.no_numpy = False
 
 
@@ -127,6 +130,7 @@ class custom_install(install):
     config.debug_mode = self.debug_mode
     config.with_ccache = self.with_ccache
     config.with_papi = self.with_papi
+    config.with_counters = self.with_counters
     config.with_numpy = not self.no_numpy
 
     # Check that the user specified a supported C++ compiler
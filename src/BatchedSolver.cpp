@@ -0,0 +1,651 @@
+#include "BatchedSolver.h"
+
+
+/**
+ * @brief Constructor initializes a single cross-section state.
+ * @details The states are added with BatchedSolver::setNumStates(...) and
+ *          BatchedSolver::setStateMaterial(...) before the source is
+ *          converged.
+ * @param geometry an optional pointer to the Geometry object
+ * @param track_generator an optional pointer to a TrackGenerator object
+ */
+BatchedSolver::BatchedSolver(Geometry* geometry,
+                             TrackGenerator* track_generator) :
+  CPUSolver(geometry, track_generator) {
+
+  _num_states = 1;
+  _num_state_groups = 0;
+  _state_materials = new std::map<int, Material*>[_num_states];
+  _batched_materials = NULL;
+  _num_batched_materials = 0;
+  _state_keffs = new FP_PRECISION[_num_states];
+  _state_keffs[0] = 1.0;
+
+  if (geometry != NULL)
+    setGeometry(geometry);
+}
+
+
+/**
+ * @brief Destructor deletes the composite Materials for the states.
+ */
+BatchedSolver::~BatchedSolver() {
+
+  clearBatchedMaterials();
+
+  if (_state_materials != NULL)
+    delete [] _state_materials;
+
+  if (_state_keffs != NULL)
+    delete [] _state_keffs;
+}
+
+
+/**
+ * @brief Returns the number of cross-section states.
+ * @return the number of states
+ */
+int BatchedSolver::getNumStates() {
+  return _num_states;
+}
+
+
+/**
+ * @brief Returns the Material which replaces one of the Geometry's Materials
+ *        in a cross-section state.
+ * @param state the state of interest
+ * @param material a Material in the Geometry
+ * @return the Material for the state, or the Geometry's Material if it is
+ *         not replaced in the state
+ */
+Material* BatchedSolver::getStateMaterial(int state, Material* material) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to return the Material for state %d since the "
+               "solver only has %d states", state, _num_states);
+
+  std::map<int, Material*>::iterator iter =
+       _state_materials[state].find(material->getId());
+
+  if (iter == _state_materials[state].end())
+    return material;
+  else
+    return iter->second;
+}
+
+
+/**
+ * @brief Returns the multiplication factor of a cross-section state.
+ * @details The value returned by Solver::getKeff() and
+ *          BatchedSolver::convergeSource(...) is that of state 0.
+ * @param state the state of interest
+ * @return the state's \f$ k_{eff} \f$
+ */
+FP_PRECISION BatchedSolver::getStateKeff(int state) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to return k_eff for state %d since the "
+               "solver only has %d states", state, _num_states);
+
+  return _state_keffs[state];
+}
+
+
+/**
+ * @brief Sets the Geometry for the Solver with the energy groups of all
+ *        cross-section states.
+ * @param geometry a pointer to the Geometry
+ */
+void BatchedSolver::setGeometry(Geometry* geometry) {
+
+  CPUSolver::setGeometry(geometry);
+
+  /* Each state has the Geometry's number of energy groups */
+  _num_state_groups = _num_groups;
+  _num_groups = _num_state_groups * _num_states;
+  _polar_times_groups = _num_groups * _num_polar;
+}
+
+
+/**
+ * @brief Sets the number of cross-section states to converge together.
+ * @details The Materials of the states which are kept are unchanged. New
+ *          states use the Geometry's Materials until they are replaced with
+ *          BatchedSolver::setStateMaterial(...).
+ * @param num_states the number of states
+ */
+void BatchedSolver::setNumStates(int num_states) {
+
+  if (num_states <= 0)
+    log_printf(ERROR, "Unable to set the number of states to %d since it "
+               "must be positive", num_states);
+
+  std::map<int, Material*>* state_materials =
+       new std::map<int, Material*>[num_states];
+
+  for (int s=0; s < std::min(num_states, _num_states); s++)
+    state_materials[s] = _state_materials[s];
+
+  delete [] _state_materials;
+  _state_materials = state_materials;
+
+  delete [] _state_keffs;
+  _state_keffs = new FP_PRECISION[num_states];
+
+  for (int s=0; s < num_states; s++)
+    _state_keffs[s] = 1.0;
+
+  _num_states = num_states;
+  _num_groups = _num_state_groups * _num_states;
+  _polar_times_groups = _num_groups * _num_polar;
+}
+
+
+/**
+ * @brief Replaces one of the Geometry's Materials in a cross-section state.
+ * @details The Material must have the same number of energy groups as the
+ *          Geometry. This method may be called from Python as follows:
+ *
+ * @code
+ *          solver.setNumStates(2)
+ *          solver.setStateMaterial(1, fuel.getId(), hot_fuel)
+ * @endcode
+ *
+ * @param state the state in which the Material is replaced
+ * @param material_id the ID of the Geometry's Material to replace
+ * @param material the Material to use in its place
+ */
+void BatchedSolver::setStateMaterial(int state, int material_id,
+                                     Material* material) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to set Material %d for state %d since the "
+               "solver only has %d states", material_id, state, _num_states);
+
+  _state_materials[state][material_id] = material;
+}
+
+
+/**
+ * @brief Builds the composite Materials with the cross-sections of all
+ *        states, indexed by Material UID.
+ * @details The cross-sections of each state are stored in the composite
+ *          Material's energy groups from state times the number of groups
+ *          per state. The scattering matrix is block-diagonal so that there
+ *          is no scattering between the states.
+ */
+void BatchedSolver::initializeMaterials() {
+
+  Solver::initializeMaterials();
+  clearBatchedMaterials();
+
+  _num_batched_materials = _num_materials;
+  _batched_materials = new Material*[_num_materials];
+
+  int num_groups = _num_state_groups;
+
+  double* sigma_t = new double[_num_groups];
+  double* sigma_a = new double[_num_groups];
+  double* sigma_f = new double[_num_groups];
+  double* nu_sigma_f = new double[_num_groups];
+  double* chi = new double[_num_groups];
+  double* sigma_s = new double[_num_groups * _num_groups];
+
+  for (int m=0; m < _num_materials; m++) {
+
+    Material* material = _materials[m];
+
+    for (int i=0; i < _num_groups * _num_groups; i++)
+      sigma_s[i] = 0.;
+
+    for (int s=0; s < _num_states; s++) {
+
+      Material* state_material = getStateMaterial(s, material);
+      int first = s * num_groups;
+
+      if (state_material->getNumEnergyGroups() != num_groups)
+        log_printf(ERROR, "Unable to use Material %d in state %d since it "
+                   "has %d energy groups rather than %d",
+                   state_material->getId(), s,
+                   state_material->getNumEnergyGroups(), num_groups);
+
+      for (int g=0; g < num_groups; g++) {
+        sigma_t[first+g] = state_material->getSigmaT()[g];
+        sigma_a[first+g] = state_material->getSigmaA()[g];
+        sigma_f[first+g] = state_material->getSigmaF()[g];
+        nu_sigma_f[first+g] = state_material->getNuSigmaF()[g];
+        chi[first+g] = state_material->getChi()[g];
+      }
+
+      /* The Material stores sigma_s by destination and then origin group,
+       * while it is set by origin and then destination group */
+      FP_PRECISION* state_sigma_s = state_material->getSigmaS();
+
+      for (int dest=0; dest < num_groups; dest++) {
+        for (int orig=0; orig < num_groups; orig++)
+          sigma_s[(first+orig)*_num_groups + first+dest] =
+               state_sigma_s[dest*num_groups+orig];
+      }
+    }
+
+    Material* batched = new Material(material->getId());
+    batched->setUid(m);
+    batched->setNumEnergyGroups(_num_groups);
+    batched->setSigmaT(sigma_t, _num_groups);
+    batched->setSigmaA(sigma_a, _num_groups);
+    batched->setSigmaF(sigma_f, _num_groups);
+    batched->setNuSigmaF(nu_sigma_f, _num_groups);
+
+    /* The chi of each state is set by group since Material::setChi(...)
+     * would normalize it over all states */
+    for (int e=0; e < _num_groups; e++)
+      batched->setChiByGroup(chi[e], e+1);
+
+    batched->setSigmaS(sigma_s, _num_groups * _num_groups);
+
+    _batched_materials[m] = batched;
+    _materials[m] = batched;
+  }
+
+  delete [] sigma_t;
+  delete [] sigma_a;
+  delete [] sigma_f;
+  delete [] nu_sigma_f;
+  delete [] chi;
+  delete [] sigma_s;
+}
+
+
+/**
+ * @brief Deletes the composite Materials if they exist.
+ */
+void BatchedSolver::clearBatchedMaterials() {
+
+  if (_batched_materials == NULL)
+    return;
+
+  for (int m=0; m < _num_batched_materials; m++)
+    delete _batched_materials[m];
+
+  delete [] _batched_materials;
+  _batched_materials = NULL;
+  _num_batched_materials = 0;
+}
+
+
+/**
+ * @brief Sums an array of rates for each energy group over the energy groups
+ *        and rows for each state.
+ * @param rates an array of rates indexed by row and energy group
+ * @param num_rows the number of rows
+ * @param totals an array to store the total rate for each state
+ */
+void BatchedSolver::reduceStateRates(FP_PRECISION* rates, int num_rows,
+                                     FP_PRECISION* totals) {
+
+  FP_PRECISION* row_rates = new FP_PRECISION[_num_states * num_rows];
+
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < num_rows; i++) {
+    for (int s=0; s < _num_states; s++)
+      row_rates[s*num_rows+i] = pairwise_sum<FP_PRECISION>(
+           &rates[size_t(i)*_num_groups + s*_num_state_groups],
+           _num_state_groups);
+  }
+
+  for (int s=0; s < _num_states; s++)
+    totals[s] = pairwise_sum<FP_PRECISION>(&row_rates[s*num_rows], num_rows);
+
+  delete [] row_rates;
+}
+
+
+/**
+ * @brief Normalizes the FSR scalar fluxes and Track boundary angular fluxes
+ *        of each state to the state's total fission source (times
+ *        \f$ \nu \f$).
+ */
+void BatchedSolver::normalizeFluxes() {
+
+  FP_PRECISION* nu_sigma_f;
+  FP_PRECISION volume;
+  FP_PRECISION* norm_factors = new FP_PRECISION[_num_states];
+
+  /* Compute the fission source for each FSR and energy group */
+  #pragma omp parallel for private(volume, nu_sigma_f) schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    nu_sigma_f = _FSR_materials[r]->getNuSigmaF();
+    volume = _FSR_volumes[r];
+
+    for (int e=0; e < _num_groups; e++)
+      _fission_sources(r,e) = nu_sigma_f[e] * _scalar_flux(r,e) * volume;
+  }
+
+  /* Compute the total fission source of each state */
+  reduceStateRates(_fission_sources, _num_FSRs, norm_factors);
+
+  for (int s=0; s < _num_states; s++)
+    norm_factors[s] = 1.0 / norm_factors[s];
+
+  /* Normalize the scalar fluxes in each FSR */
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int s=0; s < _num_states; s++) {
+      for (int g=0; g < _num_state_groups; g++)
+        _scalar_flux(r,s*_num_state_groups+g) *= norm_factors[s];
+    }
+  }
+
+  /* Normalize the angular boundary fluxes for each Track */
+  #pragma omp parallel for schedule(guided)
+  for (int i=0; i < _tot_num_tracks; i++) {
+    for (int j=0; j < 2; j++) {
+      for (int p=0; p < _num_polar; p++) {
+        for (int s=0; s < _num_states; s++) {
+          for (int g=0; g < _num_state_groups; g++) {
+            int e = s * _num_state_groups + g;
+
+            if (_boundary_flux_single != NULL)
+              _boundary_flux_single(i,j,p,e) *= norm_factors[s];
+            else
+              _boundary_flux(i,j,p,e) *= norm_factors[s];
+          }
+        }
+      }
+    }
+  }
+
+  delete [] norm_factors;
+}
+
+
+/**
+ * @brief Computes the total source (fission and scattering) in each FSR
+ *        for each state.
+ * @details The fission source of each state is divided by the state's
+ *          \f$ k_{eff} \f$. The residual of each state is that of
+ *          CPUSolver::computeFSRSources() over the state's energy groups,
+ *          so that each state converges as it would on its own.
+ * @return the largest residual of any state between this source and the
+ *         previous source
+ */
+FP_PRECISION BatchedSolver::computeFSRSources() {
+
+  int tid;
+  Material* material;
+  FP_PRECISION scatter_source;
+  FP_PRECISION fission_source;
+  FP_PRECISION* nu_sigma_f;
+  FP_PRECISION* sigma_s;
+  FP_PRECISION* sigma_t;
+  FP_PRECISION* chi;
+  int* sigma_s_begin;
+  int* sigma_s_end;
+
+  FP_PRECISION source_residual = 0.0;
+  FP_PRECISION state_residual;
+  FP_PRECISION* state_residuals = new FP_PRECISION[_num_states * _num_FSRs];
+
+  /* For all FSRs, find the source */
+  #pragma omp parallel for private(tid, material, nu_sigma_f, chi, \
+    sigma_s, sigma_t, sigma_s_begin, sigma_s_end, fission_source, \
+    scatter_source, state_residual) schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    tid = omp_get_thread_num();
+    material = _FSR_materials[r];
+    nu_sigma_f = material->getNuSigmaF();
+    chi = material->getChi();
+    sigma_s = material->getSigmaS();
+    sigma_t = material->getSigmaT();
+    sigma_s_begin = material->getSigmaSBegin();
+    sigma_s_end = material->getSigmaSEnd();
+
+    for (int s=0; s < _num_states; s++) {
+
+      int first = s * _num_state_groups;
+      int last = first + _num_state_groups;
+
+      /* Initialize the state's source residual to zero */
+      state_residual = 0.;
+
+      /* Compute the fission source of this state */
+      if (material->isFissionable()) {
+        for (int e=first; e < last; e++)
+          _fission_sources(r,e) = _scalar_flux(r,e) * nu_sigma_f[e];
+
+        fission_source = pairwise_sum<FP_PRECISION>(&_fission_sources(r,first),
+                                                    _num_state_groups);
+        fission_source /= _state_keffs[s];
+      }
+
+      else
+        fission_source = 0.0;
+
+      /* Compute the total scattering source for group G from the origin
+       * groups in the band, which lies within the state */
+      for (int G=first; G < last; G++) {
+        int begin = sigma_s_begin[G];
+        int end = sigma_s_end[G];
+        FP_PRECISION* sigma_s_G = &sigma_s[G*_num_groups];
+
+        for (int g=begin; g < end; g++)
+          _scatter_sources(tid,g) = sigma_s_G[g] * _scalar_flux(r,g);
+
+        scatter_source = pairwise_sum<FP_PRECISION>(
+             &_scatter_sources(tid,begin), end - begin);
+
+        /* Set the total source for FSR r in group G */
+        _source(r,G) = (fission_source * chi[G] + scatter_source) *
+                        ONE_OVER_FOUR_PI;
+
+        _reduced_source(r,G) = _source(r,G) / sigma_t[G];
+
+        /* Compute the norm of residual of the source in the FSR */
+        if (fabs(_source(r,G)) > 1E-10)
+          state_residual += pow((_source(r,G) - _old_source(r,G))
+                                / _source(r,G), 2);
+
+        /* Update the old source */
+        _old_source(r,G) = _source(r,G);
+      }
+
+      state_residuals[s*_num_FSRs+r] = state_residual;
+    }
+  }
+
+  /* Sum up the residuals from each FSR for each state */
+  for (int s=0; s < _num_states; s++) {
+    state_residual = pairwise_sum<FP_PRECISION>(
+         &state_residuals[s*_num_FSRs], _num_FSRs);
+    state_residual = sqrt(state_residual / (_num_FSRs * _num_state_groups));
+    source_residual = std::max(source_residual, state_residual);
+  }
+
+  delete [] state_residuals;
+
+  return source_residual;
+}
+
+
+/**
+ * @brief Computes \f$ k_{eff} \f$ of each state from the state's total
+ *        fission, absorption and leakage rates.
+ * @details The Solver's \f$ k_{eff} \f$ and leakage are those of state 0.
+ */
+void BatchedSolver::computeKeff() {
+
+  Material* material;
+  FP_PRECISION* sigma_a;
+  FP_PRECISION* nu_sigma_f;
+  FP_PRECISION volume;
+
+  FP_PRECISION* rates = new FP_PRECISION[_num_FSRs * _num_groups];
+  FP_PRECISION* tot_abs = new FP_PRECISION[_num_states];
+  FP_PRECISION* tot_fission = new FP_PRECISION[_num_states];
+  FP_PRECISION* leakage = new FP_PRECISION[_num_states];
+
+  /* Compute the volume-weighted absorption rates */
+  #pragma omp parallel for private(volume, material, sigma_a) \
+    schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    volume = _FSR_volumes[r];
+    material = _FSR_materials[r];
+    sigma_a = material->getSigmaA();
+
+    for (int e=0; e < _num_groups; e++)
+      rates[r*_num_groups+e] = sigma_a[e] * _scalar_flux(r,e) * volume;
+  }
+
+  reduceStateRates(rates, _num_FSRs, tot_abs);
+
+  /* Compute the volume-weighted fission rates */
+  #pragma omp parallel for private(volume, material, nu_sigma_f) \
+    schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    volume = _FSR_volumes[r];
+    material = _FSR_materials[r];
+    nu_sigma_f = material->getNuSigmaF();
+
+    for (int e=0; e < _num_groups; e++)
+      rates[r*_num_groups+e] = nu_sigma_f[e] * _scalar_flux(r,e) * volume;
+  }
+
+  reduceStateRates(rates, _num_FSRs, tot_fission);
+
+  /* Reduce the leakage across Tracks and polar angles for each state */
+  reduceStateRates(_boundary_leakage, 2 * _tot_num_tracks * _num_polar,
+                   leakage);
+
+  for (int s=0; s < _num_states; s++) {
+    leakage[s] *= 0.5;
+    _state_keffs[s] = tot_fission[s] / (tot_abs[s] + leakage[s]);
+
+    log_printf(DEBUG, "State %d: abs = %f, fission = %f, leakage = %f, "
+               "k_eff = %f", s, tot_abs[s], tot_fission[s], leakage[s],
+               _state_keffs[s]);
+  }
+
+  _k_eff = _state_keffs[0];
+  _leakage = leakage[0];
+
+  delete [] rates;
+  delete [] tot_abs;
+  delete [] tot_fission;
+  delete [] leakage;
+}
+
+
+/**
+ * @brief Computes \f$ k_{eff} \f$ of each state by performing a series of
+ *        transport sweeps and source updates for all states together.
+ * @details The options which cannot be batched are replaced with those of
+ *          the CPUSolver which can. The eigenvalue of each state is reported
+ *          once the source has converged and may be retrieved with
+ *          BatchedSolver::getStateKeff(...).
+ * @param max_iterations the maximum number of source iterations to allow
+ * @return the value of \f$ k_{eff} \f$ for state 0
+ */
+FP_PRECISION BatchedSolver::convergeSource(int max_iterations) {
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    log_printf(ERROR, "Unable to converge the source for %d states since "
+               "CMFD acceleration cannot be used with the BatchedSolver",
+               _num_states);
+
+  if (_energy_sweep_type == ENERGY_GAUSS_SEIDEL) {
+    log_printf(WARNING, "Sweeping the energy groups in Jacobi order since "
+               "the Gauss-Seidel sweep cannot be used with the "
+               "BatchedSolver");
+    _energy_sweep_type = ENERGY_JACOBI;
+  }
+
+  if (_source_update_type == MATERIAL_BLOCK_SOURCES) {
+    log_printf(WARNING, "Computing the sources one FSR at a time since "
+               "material-batched sources cannot be used with the "
+               "BatchedSolver");
+    _source_update_type = FSR_SOURCES;
+  }
+
+  /* A checkpoint holds a single k_eff, which is the guess for each state */
+  for (int s=0; s < _num_states; s++)
+    _state_keffs[s] = (_checkpoint_fluxes != NULL) ? _checkpoint_keff : 1.0;
+
+  FP_PRECISION k_eff = CPUSolver::convergeSource(max_iterations);
+
+  for (int s=0; s < _num_states; s++)
+    log_printf(NORMAL, "State %d: k_eff = %1.6f", s, _state_keffs[s]);
+
+  return k_eff;
+}
+
+
+/**
+ * @brief The Newton-Krylov solve is not available for batched states.
+ * @details Its state vector has a single eigenvalue, while each state has
+ *          its own. BatchedSolver::convergeSource(...) must be used instead,
+ *          so the maximum number of transport sweeps is not used.
+ * @return the value of the computed eigenvalue \f$ k_{eff} \f$
+ */
+FP_PRECISION BatchedSolver::convergeSourceKrylov(int) {
+
+  log_printf(ERROR, "Unable to converge the source for %d states with the "
+             "Newton-Krylov solve since it cannot be used with the "
+             "BatchedSolver", _num_states);
+
+  return _k_eff;
+}
+
+
+/**
+ * @brief Computes the volume-weighted, energy integrated fission rate in
+ *        each FSR for state 0 and stores them in an array indexed by FSR ID.
+ * @param fission_rates an array to store the fission rates (implicitly passed
+ *                      in as a NumPy array from Python)
+ * @param num_FSRs the number of FSRs passed in from Python
+ */
+void BatchedSolver::computeFSRFissionRates(double* fission_rates,
+                                           int num_FSRs) {
+  computeStateFissionRates(fission_rates, num_FSRs, 0);
+}
+
+
+/**
+ * @brief Computes the volume-weighted, energy integrated fission rate in
+ *        each FSR for a state and stores them in an array indexed by FSR ID.
+ * @param fission_rates an array to store the fission rates (implicitly passed
+ *                      in as a NumPy array from Python)
+ * @param num_FSRs the number of FSRs passed in from Python
+ * @param state the state of interest
+ */
+void BatchedSolver::computeStateFissionRates(double* fission_rates,
+                                             int num_FSRs, int state) {
+
+  if (state < 0 || state >= _num_states)
+    log_printf(ERROR, "Unable to compute the fission rates for state %d since "
+               "the solver only has %d states", state, _num_states);
+
+  if (num_FSRs != _num_FSRs)
+    log_printf(ERROR, "Unable to compute the fission rates for %d FSRs since "
+               "the solver has %d FSRs", num_FSRs, _num_FSRs);
+
+  log_printf(INFO, "Computing FSR fission rates for state %d...", state);
+
+  FP_PRECISION* sigma_f;
+
+  int first = state * _num_state_groups;
+  int last = first + _num_state_groups;
+
+  /* Loop over all FSRs and compute the volume-weighted fission rate */
+  #pragma omp parallel for private (sigma_f) schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    sigma_f = _FSR_materials[r]->getSigmaF();
+    fission_rates[r] = 0.0;
+
+    for (int e=first; e < last; e++)
+      fission_rates[r] += sigma_f[e] * _scalar_flux(r,e);
+  }
+}
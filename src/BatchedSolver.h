@@ -0,0 +1,95 @@
+/**
+ * @file BatchedSolver.h
+ * @brief The BatchedSolver class.
+ * @date October 16, 2026
+ */
+
+
+#ifndef BATCHEDSOLVER_H_
+#define BATCHEDSOLVER_H_
+
+#ifdef __cplusplus
+#include <map>
+#include "CPUSolver.h"
+#endif
+
+
+/**
+ * @class BatchedSolver BatchedSolver.h "src/BatchedSolver.h"
+ * @brief This is a subclass of the CPUSolver class which converges the
+ *        source for several cross-section states of the same Geometry and
+ *        Tracks in a single source iteration.
+ * @details Each state is an independent eigenvalue problem in which some
+ *          Materials are replaced by others with the same number of energy
+ *          groups, as for the fuel temperature, boron or void branch cases
+ *          of a lattice calculation. The states are an extra inner dimension
+ *          of the fluxes and sources: the solver has the Geometry's number
+ *          of energy groups times the number of states "groups", ordered by
+ *          state and then by energy group. Each Material is replaced by a
+ *          composite Material with the cross-sections of each state and a
+ *          block-diagonal scattering matrix, so that every Track segment is
+ *          swept once for all states by the CPUSolver's sweep kernels. The
+ *          fission sources, normalization and \f$ k_{eff} \f$ are computed
+ *          for each state.
+ *
+ *          The composite scattering matrices grow with the square of the
+ *          number of states, so batching is intended for few-group
+ *          problems. The states cannot be batched with CMFD, the
+ *          Gauss-Seidel energy sweep, material-batched sources or
+ *          Solver::convergeSourceKrylov().
+ */
+class BatchedSolver : public CPUSolver {
+
+protected:
+
+  /** The number of cross-section states */
+  int _num_states;
+
+  /** The number of energy groups of each state */
+  int _num_state_groups;
+
+  /** The Materials which replace the Geometry's Materials in each state,
+   *  keyed by the ID of the Material they replace */
+  std::map<int, Material*>* _state_materials;
+
+  /** The composite Materials with the cross-sections of all states,
+   *  indexed by Material UID */
+  Material** _batched_materials;
+
+  /** The number of composite Materials */
+  int _num_batched_materials;
+
+  /** The multiplication factor of each state */
+  FP_PRECISION* _state_keffs;
+
+  void initializeMaterials();
+  void clearBatchedMaterials();
+  void reduceStateRates(FP_PRECISION* rates, int num_rows,
+                        FP_PRECISION* totals);
+
+  void normalizeFluxes();
+  FP_PRECISION computeFSRSources();
+  void computeKeff();
+
+public:
+  BatchedSolver(Geometry* geometry=NULL, TrackGenerator* track_generator=NULL);
+  virtual ~BatchedSolver();
+
+  int getNumStates();
+  Material* getStateMaterial(int state, Material* material);
+  FP_PRECISION getStateKeff(int state);
+
+  void setGeometry(Geometry* geometry);
+  void setNumStates(int num_states);
+  void setStateMaterial(int state, int material_id, Material* material);
+
+  FP_PRECISION convergeSource(int max_iterations);
+  FP_PRECISION convergeSourceKrylov(int max_iterations);
+
+  void computeFSRFissionRates(double* fission_rates, int num_FSRs);
+  void computeStateFissionRates(double* fission_rates, int num_FSRs,
+                                int state);
+};
+
+
+#endif /* BATCHEDSOLVER_H_ */
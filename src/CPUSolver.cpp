@@ -15,8 +15,44 @@ CPUSolver::CPUSolver(Geometry* geometry, TrackGenerator* track_generator)
 
   setNumThreads(1);
 
+  _flux_tally_type = FSR_LOCKS;
   _FSR_locks = NULL;
-  _cmfd_surface_locks = NULL;
+  _sweep_counters = NULL;
+  _perf_event_fds = NULL;
+  _num_counter_threads = 0;
+  _thread_flux = NULL;
+  _num_cmfd_groups = 0;
+  _thread_currents = NULL;
+  _sweep_track = &CPUSolver::sweepTrackKernel<0,0>;
+  _sweep_track_groups = &CPUSolver::sweepTrackGroups<0,0>;
+
+  _source_update_type = FSR_SOURCES;
+  _material_FSRs = NULL;
+  _num_source_blocks = 0;
+  _source_block_offsets = NULL;
+  _source_block_materials = NULL;
+  _inverse_sigma_t = NULL;
+  _source_block_arrays = NULL;
+  _source_block_stride = 0;
+
+  _inverse_sin_thetas = NULL;
+
+  _exponential_storage = COMPUTE_EXPONENTIALS;
+  _single_stored_exponentials = false;
+  _segment_exponentials = NULL;
+  _segment_exponentials_single = NULL;
+
+  _single_boundary_flux = false;
+  _boundary_flux_single = NULL;
+
+  _adaptive_precision = false;
+  _reduced_precision = false;
+
+  _energy_sweep_type = ENERGY_JACOBI;
+  _num_group_blocks = 4;
+  _num_upscatter_iterations = 0;
+  _group_block_offsets = NULL;
+  _first_upscatter_block = 0;
 }
 
 
@@ -30,12 +66,46 @@ CPUSolver::~CPUSolver() {
   if (_FSR_locks != NULL)
     delete [] _FSR_locks;
 
-  if (_cmfd_surface_locks != NULL)
-    delete [] _cmfd_surface_locks;
+  clearSweepCounters();
 
+  if (_thread_flux != NULL)
+    delete [] _thread_flux;
+
+  if (_thread_currents != NULL)
+    delete [] _thread_currents;
 
   if (_surface_currents != NULL)
     delete [] _surface_currents;
+
+  if (_material_FSRs != NULL)
+    delete [] _material_FSRs;
+
+  if (_source_block_offsets != NULL)
+    delete [] _source_block_offsets;
+
+  if (_source_block_materials != NULL)
+    delete [] _source_block_materials;
+
+  if (_inverse_sigma_t != NULL)
+    delete [] _inverse_sigma_t;
+
+  if (_source_block_arrays != NULL)
+    delete [] _source_block_arrays;
+
+  if (_inverse_sin_thetas != NULL)
+    delete [] _inverse_sin_thetas;
+
+  if (_segment_exponentials != NULL)
+    delete [] _segment_exponentials;
+
+  if (_segment_exponentials_single != NULL)
+    delete [] _segment_exponentials_single;
+
+  if (_group_block_offsets != NULL)
+    delete [] _group_block_offsets;
+
+  if (_boundary_flux_single != NULL)
+    delete [] _boundary_flux_single;
 }
 
 
@@ -145,6 +215,48 @@ FP_PRECISION* CPUSolver::getSurfaceCurrents() {
 }
 
 
+/**
+ * @brief Returns the algorithm used to tally FSR scalar fluxes.
+ * @return the flux tally type (FSR_LOCKS, THREAD_PRIVATE or TRACK_COLORING)
+ */
+fluxTallyType CPUSolver::getFluxTallyType() {
+  return _flux_tally_type;
+}
+
+
+/**
+ * @brief Returns the memory needed by a FSR scalar flux tally algorithm.
+ * @details This method may be used to compare the memory footprint of the
+ *          lock-free thread-private tallies with that of the FSR locks
+ *          for the current number of threads, FSRs and energy groups:
+ *
+ * @code
+ *          locks_mem = solver.getFluxTallyMemory(openmoc.FSR_LOCKS)
+ *          private_mem = solver.getFluxTallyMemory(openmoc.THREAD_PRIVATE)
+ *          coloring_mem = solver.getFluxTallyMemory(openmoc.TRACK_COLORING)
+ * @endcode
+ *
+ * @param tally_type the flux tally type (FSR_LOCKS, THREAD_PRIVATE or
+ *        TRACK_COLORING)
+ * @return the memory needed for the flux tallies (MB)
+ */
+double CPUSolver::getFluxTallyMemory(fluxTallyType tally_type) {
+
+  double num_bytes;
+
+  if (tally_type == THREAD_PRIVATE)
+    num_bytes = double(_num_threads) * _num_FSRs * _num_groups *
+                sizeof(FP_PRECISION);
+  else if (tally_type == TRACK_COLORING)
+    num_bytes = double(_tot_num_tracks + 
+                _track_generator->getNumColors() + 1) * sizeof(int);
+  else
+    num_bytes = double(_num_FSRs) * sizeof(omp_lock_t);
+
+  return num_bytes / (1024. * 1024.);
+}
+
+
 /**
  * @brief Sets the number of shared memory OpenMP threads to use (>0).
  * @param num_threads the number of threads
@@ -162,6 +274,375 @@ void CPUSolver::setNumThreads(int num_threads) {
 }
 
 
+/**
+ * @brief Sets the algorithm used to tally FSR scalar fluxes.
+ * @details The default FSR_LOCKS algorithm uses an OpenMP mutual exclusion
+ *          lock for each FSR to atomically update the shared scalar flux.
+ *          The THREAD_PRIVATE algorithm gives each thread its own copy of
+ *          the scalar flux which is updated without locks and reduced after
+ *          each transport sweep. This avoids lock contention in FSRs crossed
+ *          by many Tracks at the cost of memory which scales with the number
+ *          of threads. The TRACK_COLORING algorithm sweeps the Tracks one
+ *          color at a time, where the TrackGenerator colors the Tracks such
+ *          that no two Tracks of the same color cross the same FSR. This
+ *          permits plain updates to the shared scalar flux without extra
+ *          memory at the cost of a thread barrier between colors. The tally
+ *          type may be set in Python as follows:
+ *
+ * @code
+ *          solver.setFluxTallyType(openmoc.THREAD_PRIVATE)
+ * @endcode
+ *
+ * @param tally_type the flux tally type (FSR_LOCKS, THREAD_PRIVATE or
+ *        TRACK_COLORING)
+ */
+void CPUSolver::setFluxTallyType(fluxTallyType tally_type) {
+  _flux_tally_type = tally_type;
+}
+
+
+/**
+ * @brief Returns the algorithm used to compute the FSR sources.
+ * @return the source update type (FSR_SOURCES or MATERIAL_BLOCK_SOURCES)
+ */
+sourceUpdateType CPUSolver::getSourceUpdateType() {
+  return _source_update_type;
+}
+
+
+/**
+ * @brief Sets the algorithm used to compute the FSR sources.
+ * @details The default FSR_SOURCES algorithm computes the fission and
+ *          scattering sources one FSR at a time. The MATERIAL_BLOCK_SOURCES
+ *          algorithm groups the FSRs by Material and computes the sources
+ *          for blocks of FSRs sharing a Material as a product of the
+ *          Material's cross-sections with the [FSRs x groups] scalar flux.
+ *          Each cross-section is then loaded once per block rather than once
+ *          per FSR, which is faster for libraries with many energy groups.
+ *          The update type may be set in Python as follows:
+ *
+ * @code
+ *          solver.setSourceUpdateType(openmoc.MATERIAL_BLOCK_SOURCES)
+ * @endcode
+ *
+ * @param update_type the source update type (FSR_SOURCES or
+ *        MATERIAL_BLOCK_SOURCES)
+ */
+void CPUSolver::setSourceUpdateType(sourceUpdateType update_type) {
+  _source_update_type = update_type;
+}
+
+
+/**
+ * @brief Returns whether the exponentials for each segment are stored.
+ * @return the exponential storage type (COMPUTE_EXPONENTIALS,
+ *         STORE_EXPONENTIALS or AUTO_STORE_EXPONENTIALS)
+ */
+exponentialStorageType CPUSolver::getExponentialStorage() {
+  return _exponential_storage;
+}
+
+
+/**
+ * @brief Returns whether the exponentials for each segment were stored for
+ *        the last call to CPUSolver::convergeSource(...).
+ * @return true if the exponentials are stored, false otherwise
+ */
+bool CPUSolver::isStoringExponentials() {
+  return (_segment_exponentials != NULL ||
+          _segment_exponentials_single != NULL);
+}
+
+
+/**
+ * @brief Returns the memory needed to store the exponentials for each
+ *        segment, polar angle and energy group.
+ * @details This may be used to decide whether to store the exponentials
+ *          before calling CPUSolver::convergeSource(...). It uses the
+ *          precision set by
+ *          CPUSolver::setStoredExponentialsSinglePrecision(...).
+ * @return the memory needed for the stored exponentials in MB
+ */
+double CPUSolver::getStoredExponentialsMemory() {
+
+  bool single = _single_stored_exponentials || _reduced_precision;
+  int size = single ? sizeof(float) : sizeof(FP_PRECISION);
+
+  return double(_track_generator->getNumSegments()) * _num_polar *
+         _num_groups * size / (1024. * 1024.);
+}
+
+
+/**
+ * @brief Sets whether the exponentials for each segment are stored.
+ * @details By default the exponentials for each segment, polar angle and
+ *          energy group are computed in each transport sweep. Since the
+ *          segment lengths and cross-sections are fixed, the
+ *          STORE_EXPONENTIALS option instead computes them once with the
+ *          exp(...) intrinsic after the FSRs are initialized, and the
+ *          transport sweeps read them from memory. The
+ *          AUTO_STORE_EXPONENTIALS option stores the exponentials only if
+ *          they need less than STORED_EXPONENTIALS_MEMORY_FRACTION of the
+ *          machine's physical memory. The storage may be set in Python as
+ *          follows:
+ *
+ * @code
+ *          solver.setExponentialStorage(openmoc.AUTO_STORE_EXPONENTIALS)
+ * @endcode
+ *
+ * @param storage_type the exponential storage type (COMPUTE_EXPONENTIALS,
+ *        STORE_EXPONENTIALS or AUTO_STORE_EXPONENTIALS)
+ */
+void CPUSolver::setExponentialStorage(exponentialStorageType storage_type) {
+  _exponential_storage = storage_type;
+}
+
+
+/**
+ * @brief Returns the order in which the energy groups are swept.
+ * @return the energy sweep type (ENERGY_JACOBI or ENERGY_GAUSS_SEIDEL)
+ */
+energySweepType CPUSolver::getEnergySweepType() {
+  return _energy_sweep_type;
+}
+
+
+/**
+ * @brief Returns the number of blocks of energy groups for the
+ *        Gauss-Seidel sweep.
+ * @return the number of energy group blocks
+ */
+int CPUSolver::getNumGroupBlocks() {
+  return _num_group_blocks;
+}
+
+
+/**
+ * @brief Returns the number of extra sweeps of the blocks of energy groups
+ *        with upscattering sources on each Gauss-Seidel sweep.
+ * @return the number of upscatter iterations
+ */
+int CPUSolver::getNumUpscatterIterations() {
+  return _num_upscatter_iterations;
+}
+
+
+/**
+ * @brief Sets the order in which the energy groups are swept.
+ * @details By default all energy groups are swept together with the sources
+ *          computed from the previous source iteration (ENERGY_JACOBI). The
+ *          ENERGY_GAUSS_SEIDEL option sweeps blocks of energy groups in
+ *          order from fast to thermal. Before each block is swept, its
+ *          downscattering sources are updated with the scalar fluxes just
+ *          computed for the faster groups, while its fission source is kept
+ *          from the start of the transport sweep. Each block costs a pass
+ *          over all Track segments, which is only amortized if the blocks
+ *          hold many energy groups. The Gauss-Seidel sweep is not used with
+ *          CMFD. The order may be set in Python as follows:
+ *
+ * @code
+ *          solver.setEnergySweepType(openmoc.ENERGY_GAUSS_SEIDEL)
+ * @endcode
+ *
+ * @param sweep_type the energy sweep type (ENERGY_JACOBI or
+ *        ENERGY_GAUSS_SEIDEL)
+ */
+void CPUSolver::setEnergySweepType(energySweepType sweep_type) {
+  _energy_sweep_type = sweep_type;
+}
+
+
+/**
+ * @brief Sets the number of blocks of energy groups for the Gauss-Seidel
+ *        sweep.
+ * @details The energy groups are divided into blocks of nearly equal size.
+ *          The number of blocks is limited to the number of energy groups.
+ *          The default is 4 blocks. Each block adds the fixed cost of a pass
+ *          over all Track segments to the transport sweep.
+ * @param num_blocks the number of energy group blocks (>0)
+ */
+void CPUSolver::setNumGroupBlocks(int num_blocks) {
+
+  if (num_blocks <= 0)
+    log_printf(ERROR, "Unable to set the number of energy group blocks to "
+               "%d since it is not a positive number", num_blocks);
+
+  _num_group_blocks = num_blocks;
+}
+
+
+/**
+ * @brief Sets the number of extra sweeps of the blocks of energy groups
+ *        with upscattering sources on each Gauss-Seidel sweep.
+ * @details These inner iterations converge the upscattering between the
+ *          thermal groups within a transport sweep. The default is zero.
+ * @param num_iterations the number of upscatter iterations (>=0)
+ */
+void CPUSolver::setNumUpscatterIterations(int num_iterations) {
+
+  if (num_iterations < 0)
+    log_printf(ERROR, "Unable to set the number of upscatter iterations to "
+               "%d since it is a negative number", num_iterations);
+
+  _num_upscatter_iterations = num_iterations;
+}
+
+
+/**
+ * @brief Sets whether the stored exponentials use single precision.
+ * @details Single precision halves the stored exponentials' memory in double
+ *          precision builds at the cost of a relative error of up to 6E-8
+ *          in each exponential.
+ * @param single_precision whether to store the exponentials as floats
+ */
+void CPUSolver::setStoredExponentialsSinglePrecision(bool single_precision) {
+  _single_stored_exponentials = single_precision;
+}
+
+
+/**
+ * @brief Returns whether the Track boundary angular fluxes are stored in
+ *        single precision.
+ * @return true if the boundary fluxes are stored in single precision
+ */
+bool CPUSolver::isBoundaryFluxSinglePrecision() {
+  return _single_boundary_flux;
+}
+
+
+/**
+ * @brief Sets whether to store the Track boundary angular fluxes in single
+ *        precision.
+ * @details The boundary fluxes are among the largest arrays for problems
+ *          with many Tracks, and are read and written for every Track on
+ *          each transport sweep. Storing them in single precision halves
+ *          their memory and bandwidth in double precision builds. Each
+ *          Track's angular flux is still swept in FP_PRECISION, and the
+ *          FSR scalar fluxes, sources and leakage are unchanged. This may
+ *          be set in Python as follows:
+ *
+ * @code
+ *          solver.setBoundaryFluxSinglePrecision(True)
+ * @endcode
+ *
+ * @param single_precision whether to store the boundary fluxes in single
+ *        precision (false by default)
+ */
+void CPUSolver::setBoundaryFluxSinglePrecision(bool single_precision) {
+  _single_boundary_flux = single_precision;
+}
+
+
+/**
+ * @brief Returns whether adaptive precision is used to converge the source.
+ * @return true if adaptive precision is used
+ */
+bool CPUSolver::isUsingAdaptivePrecision() {
+  return _adaptive_precision;
+}
+
+
+/**
+ * @brief Sets whether to use adaptive precision to converge the source.
+ * @details With adaptive precision, the Track boundary fluxes and any
+ *          stored exponentials are kept in single precision for the early
+ *          source iterations of Solver::convergeSource(...). Once the source
+ *          residual falls below ADAPTIVE_PRECISION_RESIDUAL times the single
+ *          precision machine epsilon, they are converted to FP_PRECISION for
+ *          the remaining iterations, keeping the fluxes and \f$ k_{eff} \f$.
+ *          This has no effect in single precision builds. Adaptive precision
+ *          may be used in Python as follows:
+ *
+ * @code
+ *          solver.setAdaptivePrecision(True)
+ * @endcode
+ *
+ * @param adaptive_precision whether to use adaptive precision (false by
+ *        default)
+ */
+void CPUSolver::setAdaptivePrecision(bool adaptive_precision) {
+  _adaptive_precision = adaptive_precision;
+}
+
+
+/**
+ * @brief Copies a transport sweep counter of each thread into an array.
+ * @details The counters are only kept in a build with the sweep counters
+ *          (--with-counters) and are summed over the transport sweeps since
+ *          the source iteration was last initialized. This is a helper
+ *          method for SWIG to allow users to compare the work and FSR lock
+ *          contention of each thread as a NumPy array. An example of how
+ *          this method can be called from Python is as follows:
+ *
+ * @code
+ *          num_threads = solver.getNumThreads()
+ *          wait_times = solver.getSweepCounter(openmoc.FSR_LOCK_WAIT_TIME,
+ *                                              num_threads)
+ * @endcode
+ *
+ * @param counter the sweep counter
+ * @param counts an array to store the counter of each thread (implicitly
+ *        passed in as a NumPy array from Python)
+ * @param num_threads the number of threads passed in from Python
+ */
+void CPUSolver::getSweepCounter(sweepCounterType counter, double* counts,
+                                int num_threads) {
+
+  if (_sweep_counters == NULL)
+    log_printf(ERROR, "Unable to get the sweep counters since they were "
+               "not kept. Build OpenMOC with the --with-counters option and "
+               "converge the source to count the transport sweeps.");
+
+  if (num_threads > _num_counter_threads)
+    log_printf(ERROR, "Unable to get the sweep counters for %d threads "
+               "since the transport sweeps were counted for %d threads",
+               num_threads, _num_counter_threads);
+
+  for (int t=0; t < num_threads; t++)
+    counts[t] = _sweep_counters(t, counter);
+}
+
+
+/**
+ * @brief Copies the histogram of Track sweep times summed over all threads
+ *        into an array.
+ * @details Bin i counts the Tracks swept in both directions in
+ *          [2^i, 2^(i+1)) nanoseconds. The histogram is only kept in a
+ *          build with the sweep counters (--with-counters). This is a
+ *          helper method for SWIG to allow users to retrieve the histogram
+ *          as a NumPy array. An example of how this method can be called
+ *          from Python is as follows:
+ *
+ * @code
+ *          histogram = solver.getTrackTimeHistogram(32)
+ * @endcode
+ *
+ * @param histogram an array to store the number of Tracks in each bin
+ *        (implicitly passed in as a NumPy array from Python)
+ * @param num_bins the number of bins passed in from Python
+ */
+void CPUSolver::getTrackTimeHistogram(double* histogram, int num_bins) {
+
+  if (_sweep_counters == NULL)
+    log_printf(ERROR, "Unable to get the Track sweep time histogram since "
+               "it was not kept. Build OpenMOC with the --with-counters "
+               "option and converge the source to count the transport "
+               "sweeps.");
+
+  if (num_bins > NUM_TRACK_TIME_BINS)
+    log_printf(ERROR, "Unable to get %d bins of the Track sweep time "
+               "histogram since it has %d bins", num_bins,
+               NUM_TRACK_TIME_BINS);
+
+  for (int i=0; i < num_bins; i++) {
+    histogram[i] = 0.;
+
+    for (int t=0; t < _num_counter_threads; t++)
+      histogram[i] += _sweep_counters(t, NUM_SWEEP_COUNTERS + i);
+  }
+}
+
+
 /**
  * @brief Allocates memory for Track boundary angular flux and leakage
  *        and FSR scalar flux arrays.
@@ -170,9 +651,20 @@ void CPUSolver::setNumThreads(int num_threads) {
  */
 void CPUSolver::initializeFluxArrays() {
 
+  /* Start in single precision if adaptive precision is used */
+  _reduced_precision = _adaptive_precision &&
+                       sizeof(FP_PRECISION) > sizeof(float);
+
   /* Delete old flux arrays if they exist */
-  if (_boundary_flux != NULL)
+  if (_boundary_flux != NULL) {
     delete [] _boundary_flux;
+    _boundary_flux = NULL;
+  }
+
+  if (_boundary_flux_single != NULL) {
+    delete [] _boundary_flux_single;
+    _boundary_flux_single = NULL;
+  }
 
   if (_boundary_leakage != NULL)
     delete [] _boundary_leakage;
@@ -180,17 +672,32 @@ void CPUSolver::initializeFluxArrays() {
   if (_scalar_flux != NULL)
     delete [] _scalar_flux;
 
+  if (_thread_flux != NULL) {
+    delete [] _thread_flux;
+    _thread_flux = NULL;
+  }
+
   int size;
 
   /* Allocate memory for the Track boundary flux and leakage arrays */
   try{
     size = 2 * _tot_num_tracks * _polar_times_groups;
-    _boundary_flux = new FP_PRECISION[size];
     _boundary_leakage = new FP_PRECISION[size];
 
+    if (_single_boundary_flux || _reduced_precision)
+      _boundary_flux_single = new float[size];
+    else
+      _boundary_flux = new FP_PRECISION[size];
+
     /* Allocate an array for the FSR scalar flux */
     size = _num_FSRs * _num_groups;
     _scalar_flux = new FP_PRECISION[size];
+
+    /* Allocate an array for each thread's private FSR scalar flux */
+    if (_flux_tally_type == THREAD_PRIVATE) {
+      size = _num_threads * _num_FSRs * _num_groups;
+      _thread_flux = new FP_PRECISION[size];
+    }
   }
   catch(std::exception &e) {
     log_printf(ERROR, "Could not allocate memory for the Solver's fluxes. "
@@ -265,6 +772,15 @@ void CPUSolver::initializePolarQuadrature() {
 
   _quad = new Quadrature(_quadrature_type, _num_polar);
   _polar_times_groups = _num_groups * _num_polar;
+
+  /* Compute the inverse sines of the polar angles for the exponentials */
+  if (_inverse_sin_thetas != NULL)
+    delete [] _inverse_sin_thetas;
+
+  _inverse_sin_thetas = new FP_PRECISION[_num_polar];
+
+  for (int p=0; p < _num_polar; p++)
+    _inverse_sin_thetas[p] = 1. / _quad->getSinTheta(p);
 }
 
 
@@ -290,33 +806,139 @@ void CPUSolver::buildExpInterpTable() {
       _polar_weights(i,p) = azim_weight*_quad->getMultiple(p)*FOUR_PI;
   }
 
-  /* Set size of interpolation table */
-  int num_array_values = 10 * sqrt(1./(8.*_source_convergence_thresh*1e-2));
-  _exp_table_spacing = 10. / num_array_values;
-  _exp_table_size = _two_times_num_polar * num_array_values;
-  _exp_table_max_index = _exp_table_size - _two_times_num_polar - 1.;
+  /* Delete the old table if it exists */
+  if (_exp_table != NULL) {
+    delete [] _exp_table;
+    _exp_table = NULL;
+  }
+
+  if (_exp_table_single != NULL) {
+    delete [] _exp_table_single;
+    _exp_table_single = NULL;
+  }
+
+  /* By default the table's error is 1% of the source convergence threshold */
+  double max_error = _exp_table_target_error;
+  if (max_error == 0.)
+    max_error = 1E-2 * _source_convergence_thresh;
+
+  /* Find the smallest and largest sines of the polar angles */
+  double min_sin_theta = 1.;
+  double max_sin_theta = 0.;
+
+  for (int p=0; p < _num_polar; p++) {
+    min_sin_theta = std::min(min_sin_theta, double(_quad->getSinTheta(p)));
+    max_sin_theta = std::max(max_sin_theta, double(_quad->getSinTheta(p)));
+  }
+
+  /* Store the table in single precision if it is allowed and its rounding
+   * error is at most 10% of the error budget */
+  double rounding_error = 2. * std::numeric_limits<FP_PRECISION>::epsilon();
+  bool single = false;
+
+  if (_allow_single_exp_table && sizeof(FP_PRECISION) > sizeof(float)) {
+    if (2. * FLT_EPSILON <= 0.1 * max_error) {
+      single = true;
+      rounding_error = 2. * FLT_EPSILON;
+    }
+    else
+      log_printf(WARNING, "Unable to store the exponential table in single "
+                 "precision since its rounding error would exceed 10%% of "
+                 "the maximum error %.1E", max_error);
+  }
+
+  /* The table cannot be more accurate than its rounding error allows */
+  if (max_error < 10. * rounding_error) {
+    log_printf(INFO, "Raising the exponential table maximum error from "
+               "%.1E to %.1E since it is limited by the rounding error",
+               max_error, 10. * rounding_error);
+    max_error = 10. * rounding_error;
+  }
 
-  log_printf(DEBUG, "Exponential interpolation table size: %i, max index: %i",
-             _exp_table_size, _exp_table_max_index);
+  /* Beyond the maximum optical length the exponential is within 10% of the
+   * remaining error budget of one, and the interpolation is given the rest */
+  double interp_error = max_error - rounding_error;
+  _exp_table_max_tau = max_sin_theta * log(10. / interp_error);
+  interp_error *= 0.9;
+
+  /* Find the spacing needed by linear and quadratic interpolation, where
+   * the error for the nearest table point is bounded by h^2/(8 sin^2) and
+   * h^3/(48 sin^3), respectively */
+  double spacing[2];
+  spacing[0] = min_sin_theta * sqrt(8. * interp_error);
+  spacing[1] = min_sin_theta * cbrt(48. * interp_error);
+
+  /* Use the interpolation order which gives the smallest table */
+  int num_points[2];
+  for (int o=0; o < 2; o++) {
+    num_points[o] = int(ceil(_exp_table_max_tau / spacing[o])) + 1;
+    spacing[o] = _exp_table_max_tau / (num_points[o] - 1);
+  }
+
+  if (num_points[1] * 3 < num_points[0] * 2)
+    _exp_table_order = 2;
+  else
+    _exp_table_order = 1;
+
+  int num_coeffs = _exp_table_order + 1;
+  int num_array_values = num_points[_exp_table_order-1];
+  _exp_table_spacing = spacing[_exp_table_order-1];
+  _exp_table_size = num_array_values * _num_polar * num_coeffs;
+  _exp_table_max_index = _exp_table_size - _num_polar * num_coeffs;
+
+  /* Compute the bound on the table's maximum error */
+  double h = _exp_table_spacing / min_sin_theta;
+  if (_exp_table_order == 2)
+    _exp_table_max_error = h * h * h / 48.;
+  else
+    _exp_table_max_error = h * h / 8.;
+
+  _exp_table_max_error += exp(-_exp_table_max_tau / max_sin_theta) +
+                          rounding_error;
 
   /* Allocate array for the table */
-  _exp_table = new FP_PRECISION[_exp_table_size];
-
-  FP_PRECISION expon;
-  FP_PRECISION intercept;
-  FP_PRECISION slope;
-
-  /* Create exponential linear interpolation table */
-  for (int i=0; i < num_array_values; i ++){
-    for (int p=0; p < _num_polar; p++){
-      expon = exp(- (i * _exp_table_spacing) / _quad->getSinTheta(p));
-      slope = - expon / _quad->getSinTheta(p);
-      intercept = expon * (1 + (i * _exp_table_spacing)/_quad->getSinTheta(p));
-      _exp_table[_two_times_num_polar * i + 2 * p] = slope;
-      _exp_table[_two_times_num_polar * i + 2 * p + 1] = intercept;
+  FP_PRECISION* exp_table = new FP_PRECISION[_exp_table_size];
+
+  /* Store the Taylor series of the exponential at each point */
+  for (int i=0; i < num_array_values; i++) {
+    for (int p=0; p < _num_polar; p++) {
+
+      double sin_theta = _quad->getSinTheta(p);
+      double expon = exp(- (i * double(_exp_table_spacing)) / sin_theta);
+      int index = (i * _num_polar + p) * num_coeffs;
+
+      exp_table[index] = -expm1(- (i * double(_exp_table_spacing)) /
+                                sin_theta);
+      exp_table[index+1] = expon / sin_theta;
+
+      if (_exp_table_order == 2)
+        exp_table[index+2] = -expon / (2. * sin_theta * sin_theta);
     }
   }
 
+  /* Convert the table to single precision */
+  if (single) {
+    _exp_table_single = new float[_exp_table_size];
+
+    for (int i=0; i < _exp_table_size; i++)
+      _exp_table_single[i] = float(exp_table[i]);
+
+    delete [] exp_table;
+  }
+  else
+    _exp_table = exp_table;
+
+  bool single_table = single || sizeof(FP_PRECISION) == sizeof(float);
+
+  log_printf(NORMAL, "Exponential table uses %s interpolation with %d "
+             "points and a maximum error of %.1E in %.1f KB of %s "
+             "precision", (_exp_table_order == 2) ? "quadratic" : "linear",
+             num_array_values, _exp_table_max_error,
+             getExpTableMemory() * 1024., single_table ? "single" : "double");
+
+  log_printf(DEBUG, "Exponential table spacing: %f, maximum optical "
+             "length: %f", _exp_table_spacing, _exp_table_max_tau);
+
   /* Compute the reciprocal of the table entry spacing */
   _inverse_exp_table_spacing = 1.0 / _exp_table_spacing;
 
@@ -341,13 +963,15 @@ void CPUSolver::initializeFSRs() {
   if (_FSR_materials != NULL)
     delete [] _FSR_materials;
 
+  /* Delete old FSR locks if they exist */
+  if (_FSR_locks != NULL) {
+    delete [] _FSR_locks;
+    _FSR_locks = NULL;
+  }
+
   _FSR_volumes = (FP_PRECISION*)calloc(_num_FSRs, sizeof(FP_PRECISION));
   _FSR_materials = new Material*[_num_FSRs];
-  _FSR_locks = new omp_lock_t[_num_FSRs];
 
-  int num_segments;
-  segment* curr_segment;
-  segment* segments;
   FP_PRECISION volume;
   Material* material;
   Universe* univ_zero = _geometry->getUniverse(0);
@@ -357,38 +981,406 @@ void CPUSolver::initializeFSRs() {
   for (int i=0; i < _tot_num_tracks; i++) {
 
     int azim_index = _tracks[i]->getAzimAngleIndex();
-    num_segments = _tracks[i]->getNumSegments();
-    segments = _tracks[i]->getSegments();
 
-    for (int s=0; s < num_segments; s++) {
-      curr_segment = &segments[s];
-      volume = curr_segment->_length * _azim_weights[azim_index];
-      _FSR_volumes[curr_segment->_region_id] += volume;
+    for (int s=_segment_offsets[i]; s < _segment_offsets[i+1]; s++) {
+      volume = _segment_lengths[s] * _azim_weights[azim_index];
+      _FSR_volumes[_segment_FSR_ids[s]] += volume;
     }
   }
 
+  /* Build the array of Materials indexed by the segment Material UIDs */
+  initializeMaterials();
+
   /* Loop over all FSRs to extract FSR material pointers */
   #pragma omp parallel for private(material) schedule(guided)
   for (int r=0; r < _num_FSRs; r++) {
 
     /* Assign the Material corresponding to this FSR */
     material = _geometry->findFSRMaterial(r);
-    _FSR_materials[r] = material;
+    _FSR_materials[r] = _materials[material->getUid()];
 
     log_printf(DEBUG, "FSR ID = %d has Material ID = %d "
                "and volume = %f", r, _FSR_materials[r]->getUid(), 
                _FSR_volumes[r]);
   }
 
-  /* Loop over all FSRs to initialize OpenMP locks */
+  /* Report the memory used by the FSR scalar flux tallies */
+  if (_flux_tally_type == THREAD_PRIVATE)
+    log_printf(NORMAL, "Thread-private FSR fluxes use %.2f MB (FSR locks "
+               "would use %.2f MB)", getFluxTallyMemory(THREAD_PRIVATE),
+               getFluxTallyMemory(FSR_LOCKS));
+  else if (_flux_tally_type == TRACK_COLORING)
+    log_printf(NORMAL, "Track coloring uses %d colors and %.2f MB (FSR locks "
+               "would use %.2f MB)", _track_generator->getNumColors(),
+               getFluxTallyMemory(TRACK_COLORING),
+               getFluxTallyMemory(FSR_LOCKS));
+  else
+    log_printf(NORMAL, "FSR locks use %.2f MB (thread-private FSR fluxes "
+               "would use %.2f MB)", getFluxTallyMemory(FSR_LOCKS),
+               getFluxTallyMemory(THREAD_PRIVATE));
+
+  /* Initialize OpenMP locks for atomic FSR scalar flux updates */
+  if (_flux_tally_type == FSR_LOCKS) {
+
+    _FSR_locks = new omp_lock_t[_num_FSRs];
+
+    /* Loop over all FSRs to initialize OpenMP locks */
+    #pragma omp parallel for schedule(guided)
+    for (int r=0; r < _num_FSRs; r++)
+      omp_init_lock(&_FSR_locks[r]);
+  }
+
+  /* Group the FSRs by Material for material-batched source updates */
+  initializeSourceBlocks();
+
+  /* Compute and store the exponentials for each segment if requested */
+  initializeSegmentExponentials();
+
+  /* Allocate the transport sweep counters in a build which keeps them */
+  initializeSweepCounters();
+
+  return;
+}
+
+
+/**
+ * @brief Computes and stores the exponentials for each Track segment, polar
+ *        angle and energy group.
+ * @details The exponentials are computed with the exp(...) intrinsic and
+ *          stored in the order of the TrackGenerator's flat segment arrays.
+ *          This method does nothing unless the exponentials are to be
+ *          stored, or if AUTO_STORE_EXPONENTIALS is selected and they would
+ *          need more than STORED_EXPONENTIALS_MEMORY_FRACTION of the
+ *          machine's physical memory.
+ */
+void CPUSolver::initializeSegmentExponentials() {
+
+  /* Delete the old stored exponentials if they exist */
+  if (_segment_exponentials != NULL) {
+    delete [] _segment_exponentials;
+    _segment_exponentials = NULL;
+  }
+
+  if (_segment_exponentials_single != NULL) {
+    delete [] _segment_exponentials_single;
+    _segment_exponentials_single = NULL;
+  }
+
+  if (_exponential_storage == COMPUTE_EXPONENTIALS)
+    return;
+
+  double memory = getStoredExponentialsMemory();
+
+  if (_exponential_storage == AUTO_STORE_EXPONENTIALS) {
+
+    double physical_memory = double(sysconf(_SC_PHYS_PAGES)) *
+                             sysconf(_SC_PAGE_SIZE) / (1024. * 1024.);
+
+    if (memory > STORED_EXPONENTIALS_MEMORY_FRACTION * physical_memory) {
+      log_printf(NORMAL, "Computing exponentials in each sweep since storing "
+                 "them would use %.2f MB of %.2f MB of memory", memory,
+                 physical_memory);
+      return;
+    }
+  }
+
+  log_printf(NORMAL, "Stored exponentials use %.2f MB", memory);
+
+  bool single = (_single_stored_exponentials || _reduced_precision) &&
+                sizeof(FP_PRECISION) > sizeof(float);
+
+  if (single)
+    _segment_exponentials_single =
+         new float[size_t(_tot_num_segments) * _polar_times_groups];
+  else
+    _segment_exponentials =
+         new FP_PRECISION[size_t(_tot_num_segments) * _polar_times_groups];
+
+  /* Loop over all segments and compute the exponentials */
   #pragma omp parallel for schedule(guided)
+  for (int s=0; s < _tot_num_segments; s++) {
+
+    FP_PRECISION length = _segment_lengths[s];
+    FP_PRECISION* sigma_t = _materials[_segment_material_uids[s]]->getSigmaT();
+    size_t offset = size_t(s) * _polar_times_groups;
+
+    for (int p=0; p < _num_polar; p++) {
+      for (int e=0; e < _num_groups; e++) {
+
+        FP_PRECISION exponential =
+             -expm1(- sigma_t[e] * length * _inverse_sin_thetas[p]);
+
+        if (single)
+          _segment_exponentials_single[offset + p*_num_groups + e] =
+               float(exponential);
+        else
+          _segment_exponentials[offset + p*_num_groups + e] = exponential;
+      }
+    }
+  }
+}
+
+
+/**
+ * @brief Groups the FSRs into blocks which share a Material for the
+ *        material-batched source computation.
+ * @details The FSR IDs are sorted by Material UID and each Material's FSRs
+ *          are split into blocks of at most SOURCE_BLOCK_SIZE FSRs. The
+ *          inverse of each Material's total cross-section is also
+ *          precomputed for the reduced sources, and each thread's arrays
+ *          for a block's fluxes and sources are allocated. This method does
+ *          nothing unless the MATERIAL_BLOCK_SOURCES update type is in use.
+ */
+void CPUSolver::initializeSourceBlocks() {
+
+  /* Delete old source blocks if they exist */
+  if (_material_FSRs != NULL) {
+    delete [] _material_FSRs;
+    _material_FSRs = NULL;
+  }
+
+  if (_source_block_offsets != NULL) {
+    delete [] _source_block_offsets;
+    _source_block_offsets = NULL;
+  }
+
+  if (_source_block_materials != NULL) {
+    delete [] _source_block_materials;
+    _source_block_materials = NULL;
+  }
+
+  if (_inverse_sigma_t != NULL) {
+    delete [] _inverse_sigma_t;
+    _inverse_sigma_t = NULL;
+  }
+
+  if (_source_block_arrays != NULL) {
+    delete [] _source_block_arrays;
+    _source_block_arrays = NULL;
+  }
+
+  _num_source_blocks = 0;
+
+  if (_source_update_type != MATERIAL_BLOCK_SOURCES)
+    return;
+
+  /* Count the number of FSRs filled by each Material */
+  int* material_offsets = new int[_num_materials+1];
+  memset(material_offsets, 0, (_num_materials+1) * sizeof(int));
+
   for (int r=0; r < _num_FSRs; r++)
-    omp_init_lock(&_FSR_locks[r]);
+    material_offsets[_FSR_materials[r]->getUid()+1]++;
+
+  /* Count the number of blocks for each Material and find each Material's
+   * offset into the array of sorted FSR IDs */
+  for (int m=0; m < _num_materials; m++) {
+    _num_source_blocks += (material_offsets[m+1] + SOURCE_BLOCK_SIZE - 1)
+                          / SOURCE_BLOCK_SIZE;
+    material_offsets[m+1] += material_offsets[m];
+  }
 
-  return;
+  /* Sort the FSR IDs by Material UID, keeping each Material's FSRs in
+   * ascending order */
+  _material_FSRs = new int[_num_FSRs];
+  int* material_counts = new int[_num_materials];
+  memset(material_counts, 0, _num_materials * sizeof(int));
+
+  for (int r=0; r < _num_FSRs; r++) {
+    int m = _FSR_materials[r]->getUid();
+    _material_FSRs[material_offsets[m] + material_counts[m]] = r;
+    material_counts[m]++;
+  }
+
+  /* Split each Material's FSRs into blocks */
+  _source_block_offsets = new int[_num_source_blocks+1];
+  _source_block_materials = new int[_num_source_blocks];
+
+  int block = 0;
+  for (int m=0; m < _num_materials; m++) {
+    for (int i=material_offsets[m]; i < material_offsets[m+1];
+         i += SOURCE_BLOCK_SIZE) {
+      _source_block_offsets[block] = i;
+      _source_block_materials[block] = m;
+      block++;
+    }
+  }
+
+  _source_block_offsets[_num_source_blocks] = _num_FSRs;
+
+  /* Precompute the inverse total cross-sections for the reduced sources */
+  _inverse_sigma_t = new FP_PRECISION[_num_materials * _num_groups];
+
+  for (int m=0; m < _num_materials; m++) {
+    FP_PRECISION* sigma_t = _materials[m]->getSigmaT();
+    for (int e=0; e < _num_groups; e++)
+      _inverse_sigma_t[m*_num_groups+e] = 1.0 / sigma_t[e];
+  }
+
+  /* Allocate each thread's arrays for a block's fluxes and sources, padded
+   * to a multiple of the cache line size */
+  int block_size = _num_groups * SOURCE_BLOCK_SIZE;
+  _source_block_stride = ((2 * block_size + 2 * SOURCE_BLOCK_SIZE) *
+                          sizeof(FP_PRECISION) + 63) / 64 * 64 /
+                         sizeof(FP_PRECISION);
+  _source_block_arrays =
+       new FP_PRECISION[_num_threads * _source_block_stride];
+
+  delete [] material_offsets;
+  delete [] material_counts;
+
+  log_printf(INFO, "Material-batched sources use %d blocks of FSRs for "
+             "%d Materials", _num_source_blocks, _num_materials);
 }
 
 
+/**
+ * @brief Allocates and zeroes the transport sweep counters of each thread.
+ * @details This method does nothing unless OpenMOC was built with the
+ *          sweep counters (--with-counters). Each thread also opens the
+ *          perf event hardware counters of the CPU cycles and last level
+ *          cache misses of its own thread, if the kernel permits it. This
+ *          method is called by CPUSolver::initializeFSRs() and by
+ *          CPUSolver::transportSweep() if the number of threads changes,
+ *          and should not be called directly by the user.
+ */
+void CPUSolver::initializeSweepCounters() {
+
+#ifdef SWEEP_COUNTERS
+  clearSweepCounters();
+
+  _num_counter_threads = _num_threads;
+
+  int size = _num_threads * (NUM_SWEEP_COUNTERS + NUM_TRACK_TIME_BINS);
+  _sweep_counters = new double[size];
+  memset(_sweep_counters, 0, size * sizeof(double));
+
+  _perf_event_fds = new int[2 * _num_threads];
+
+  #pragma omp parallel num_threads(_num_threads)
+  {
+    int tid = omp_get_thread_num();
+    _perf_event_fds[2*tid] = -1;
+    _perf_event_fds[2*tid+1] = -1;
+
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    /* Count the events of this thread on any CPU */
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    _perf_event_fds[2*tid] = syscall(__NR_perf_event_open, &attr, 0, -1,
+                                     -1, 0);
+
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    _perf_event_fds[2*tid+1] = syscall(__NR_perf_event_open, &attr, 0, -1,
+                                       -1, 0);
+#endif
+  }
+
+  if (_perf_event_fds[0] == -1)
+    log_printf(NORMAL, "Counting the transport sweeps without the hardware "
+               "performance counters since perf events are not available");
+  else
+    log_printf(NORMAL, "Counting the transport sweeps with the hardware "
+               "performance counters");
+#endif
+}
+
+
+/**
+ * @brief Deletes the transport sweep counters and closes the hardware
+ *        performance counters.
+ */
+void CPUSolver::clearSweepCounters() {
+
+  if (_sweep_counters != NULL) {
+    delete [] _sweep_counters;
+    _sweep_counters = NULL;
+  }
+
+  if (_perf_event_fds != NULL) {
+#ifdef SWEEP_COUNTERS
+    for (int i=0; i < 2 * _num_counter_threads; i++) {
+      if (_perf_event_fds[i] != -1)
+        close(_perf_event_fds[i]);
+    }
+#endif
+    delete [] _perf_event_fds;
+    _perf_event_fds = NULL;
+  }
+
+  _num_counter_threads = 0;
+}
+
+
+/**
+ * @brief Adds the hardware performance counters of each thread to its
+ *        sweep counters.
+ * @details The counters are read before a transport sweep with a sign of
+ *          -1 and after it with a sign of 1 to count the events in the
+ *          sweep. Each thread reads the counters which it opened, so that
+ *          the events of OpenMP's persistent worker threads are counted.
+ * @param sign the sign of the counts (1 or -1)
+ */
+#ifdef SWEEP_COUNTERS
+void CPUSolver::readHardwareCounters(double sign) {
+
+  if (_perf_event_fds == NULL || _perf_event_fds[0] == -1)
+    return;
+
+  #pragma omp parallel num_threads(_num_counter_threads)
+  {
+    int tid = omp_get_thread_num();
+    uint64_t count;
+
+    for (int i=0; i < 2; i++) {
+      int fd = _perf_event_fds[2*tid+i];
+
+      if (fd != -1 && read(fd, &count, sizeof(count)) == sizeof(count))
+        _sweep_counters(tid, SWEEP_CYCLES + i) += sign * double(count);
+    }
+  }
+}
+#else
+void CPUSolver::readHardwareCounters(double) { }
+#endif
+
+
+/**
+ * @brief Counts the segments and exponentials of a Track swept by this
+ *        thread and the time taken to sweep it.
+ * @param track_id the ID of the Track
+ * @param num_groups the number of energy groups swept
+ * @param time the time taken to sweep the Track in both directions (seconds)
+ */
+#ifdef SWEEP_COUNTERS
+void CPUSolver::countTrackSweep(int track_id, int num_groups, double time) {
+
+  int tid = omp_get_thread_num();
+  int num_segments = _segment_offsets[track_id+1] - _segment_offsets[track_id];
+
+  _sweep_counters(tid, SEGMENTS_SWEPT) += 2 * num_segments;
+
+  if (_segment_exponentials == NULL && _segment_exponentials_single == NULL)
+    _sweep_counters(tid, EXPONENTIALS_EVALUATED) +=
+         2. * num_segments * _num_polar * num_groups;
+
+  /* Find the histogram bin from the exponent of the time in nanoseconds */
+  int bin;
+  frexp(time * 1.E9, &bin);
+  bin = std::max(0, std::min(bin - 1, NUM_TRACK_TIME_BINS - 1));
+
+  _sweep_counters(tid, NUM_SWEEP_COUNTERS + bin)++;
+}
+#else
+void CPUSolver::countTrackSweep(int, int, double) { }
+#endif
+
+
 /**
  * @brief Initializes Cmfd object for acceleration prior to source iteration.
  * @details Instantiates a dummy Cmfd object if one was not assigned to
@@ -401,18 +1393,27 @@ void CPUSolver::initializeCmfd() {
   /* Call parent class method */
   Solver::initializeCmfd();
 
-  /* Delete old Cmfd surface currents array it it exists */
+  /* Delete old Cmfd surface currents arrays if they exist */
   if (_surface_currents != NULL)
     delete [] _surface_currents;
 
+  if (_thread_currents != NULL)
+    delete [] _thread_currents;
+
+  _num_cmfd_groups = _cmfd->getNumCmfdGroups();
+
   int size;
 
-  /* Allocate memory for the Cmfd Mesh surface currents array */
+  /* Allocate memory for the Cmfd Mesh surface currents arrays */
   try{
 
     /* Allocate an array for the Cmfd Mesh surface currents */
-    size = _num_mesh_cells * _cmfd->getNumCmfdGroups() * 8;
+    size = _num_mesh_cells * _num_cmfd_groups * 8;
     _surface_currents = new FP_PRECISION[size];
+
+    /* Allocate an array for each thread's private surface currents */
+    size *= _num_threads;
+    _thread_currents = new FP_PRECISION[size];
   }
   catch(std::exception &e) {
     log_printf(ERROR, "Could not allocate memory for the Solver's Cmfd "
@@ -421,15 +1422,269 @@ void CPUSolver::initializeCmfd() {
 
   _cmfd->setSurfaceCurrents(_surface_currents);
 
-  /* Initialize an array of OpenMP locks for each Cmfd Mesh surface */ 
-  _cmfd_surface_locks = new omp_lock_t[_num_mesh_cells * 8];
+  return;
+}
+
+
+/**
+ * @brief Selects the Track sweep kernel for the number of energy groups and
+ *        polar angles.
+ * @details Kernels with a fixed number of energy groups and polar angles
+ *          are compiled for 1, 2, 7 and 8 energy groups and 1, 2 and 3
+ *          polar angles. Other problem sizes use a kernel which loops over
+ *          the number of energy groups and polar angles given at runtime.
+ */
+void CPUSolver::initializeSweepKernels() {
+
+  switch (_num_groups) {
+  case 1:
+    selectSweepKernel<1>();
+    break;
+  case 2:
+    selectSweepKernel<2>();
+    break;
+  case 7:
+    selectSweepKernel<7>();
+    break;
+  case 8:
+    selectSweepKernel<8>();
+    break;
+  default:
+    _sweep_track = &CPUSolver::sweepTrackKernel<0,0>;
+    _sweep_track_groups = &CPUSolver::sweepTrackGroups<0,0>;
+  }
+
+  if (_sweep_track == &CPUSolver::sweepTrackKernel<0,0>)
+    log_printf(INFO, "Using the generic sweep kernel for %d groups and %d "
+               "polar angles", _num_groups, _num_polar);
+  else
+    log_printf(INFO, "Using a specialized sweep kernel for %d groups and %d "
+               "polar angles", _num_groups, _num_polar);
+
+  initializeGroupBlocks();
+}
+
+
+/**
+ * @brief Divides the energy groups into blocks for the Gauss-Seidel sweep.
+ * @details The blocks are only built if ENERGY_GAUSS_SEIDEL is selected
+ *          and CMFD is not used. The first block with upscattering sources
+ *          is found from the Materials' bands of non-zero scattering
+ *          cross-sections. This method is called by
+ *          CPUSolver::initializeSweepKernels() and should not be called
+ *          directly by the user.
+ */
+void CPUSolver::initializeGroupBlocks() {
+
+  if (_group_block_offsets != NULL) {
+    delete [] _group_block_offsets;
+    _group_block_offsets = NULL;
+  }
+
+  if (_energy_sweep_type == ENERGY_JACOBI)
+    return;
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
+    log_printf(WARNING, "Sweeping all energy groups together since the "
+               "Gauss-Seidel energy sweep is not used with CMFD");
+    return;
+  }
+
+  int num_blocks = std::min(_num_group_blocks, _num_groups);
+
+  _group_block_offsets = new int[num_blocks+1];
+
+  for (int b=0; b <= num_blocks; b++)
+    _group_block_offsets[b] = b * _num_groups / num_blocks;
+
+  /* Find the fastest group with an upscattering source */
+  int first_upscatter_group = _num_groups;
+
+  for (int m=0; m < _num_materials; m++) {
+    int* sigma_s_end = _materials[m]->getSigmaSEnd();
+
+    for (int G=0; G < _num_groups; G++) {
+      if (sigma_s_end[G] > G + 1) {
+        first_upscatter_group = std::min(first_upscatter_group, G);
+        break;
+      }
+    }
+  }
+
+  _first_upscatter_block = num_blocks;
+
+  for (int b=num_blocks-1; b >= 0; b--) {
+    if (_group_block_offsets[b+1] > first_upscatter_group)
+      _first_upscatter_block = b;
+  }
+
+  log_printf(NORMAL, "Sweeping %d energy group blocks in Gauss-Seidel order "
+             "with upscattering from block %d", num_blocks,
+             _first_upscatter_block);
+}
+
+
+/**
+ * @brief Selects the Track sweep kernel for a fixed number of energy groups
+ *        and the number of polar angles.
+ */
+template <int NUM_GROUPS>
+void CPUSolver::selectSweepKernel() {
+
+  switch (_num_polar) {
+  case 1:
+    _sweep_track = &CPUSolver::sweepTrackKernel<NUM_GROUPS,1>;
+    _sweep_track_groups = &CPUSolver::sweepTrackGroups<NUM_GROUPS,1>;
+    break;
+  case 2:
+    _sweep_track = &CPUSolver::sweepTrackKernel<NUM_GROUPS,2>;
+    _sweep_track_groups = &CPUSolver::sweepTrackGroups<NUM_GROUPS,2>;
+    break;
+  case 3:
+    _sweep_track = &CPUSolver::sweepTrackKernel<NUM_GROUPS,3>;
+    _sweep_track_groups = &CPUSolver::sweepTrackGroups<NUM_GROUPS,3>;
+    break;
+  default:
+    _sweep_track = &CPUSolver::sweepTrackKernel<0,0>;
+    _sweep_track_groups = &CPUSolver::sweepTrackGroups<0,0>;
+  }
+}
+
+
+/**
+ * @brief Mixes the fluxes from a transport sweep with those from previous
+ *        iterations if Anderson acceleration is used.
+ * @details The boundary fluxes are mixed in a copy in FP_PRECISION if they
+ *          are stored in single precision.
+ */
+void CPUSolver::accelerateFluxes() {
+
+  if (_boundary_flux_single == NULL) {
+    Solver::accelerateFluxes();
+    return;
+  }
+
+  if (_anderson_fluxes == NULL)
+    return;
+
+  long size = 2 * long(_tot_num_tracks) * _polar_times_groups;
+  FP_PRECISION* boundary_flux = new FP_PRECISION[size];
 
-  /* Loop over all mesh cell surfaces to initialize OpenMP locks */
   #pragma omp parallel for schedule(guided)
-  for (int r=0; r < _num_mesh_cells*8; r++)
-    omp_init_lock(&_cmfd_surface_locks[r]);
+  for (long i=0; i < size; i++)
+    boundary_flux[i] = _boundary_flux_single[i];
 
-  return;
+  andersonMix(_scalar_flux, boundary_flux);
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < size; i++)
+    _boundary_flux_single[i] = boundary_flux[i];
+
+  delete [] boundary_flux;
+}
+
+
+/**
+ * @brief Copies the FSR scalar fluxes followed by the Track boundary angular
+ *        fluxes into an array.
+ * @param fluxes the array to store the fluxes
+ */
+void CPUSolver::getFluxes(FP_PRECISION* fluxes) {
+
+  if (_boundary_flux_single == NULL) {
+    Solver::getFluxes(fluxes);
+    return;
+  }
+
+  long num_scalar_fluxes = long(_num_FSRs) * _num_groups;
+  long size = 2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  memcpy(fluxes, _scalar_flux, num_scalar_fluxes * sizeof(FP_PRECISION));
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < size; i++)
+    fluxes[num_scalar_fluxes + i] = _boundary_flux_single[i];
+}
+
+
+/**
+ * @brief Sets the FSR scalar fluxes and Track boundary angular fluxes from
+ *        an array.
+ * @param fluxes the FSR scalar fluxes followed by the boundary fluxes
+ */
+void CPUSolver::setFluxes(FP_PRECISION* fluxes) {
+
+  if (_boundary_flux_single == NULL) {
+    Solver::setFluxes(fluxes);
+    return;
+  }
+
+  long num_scalar_fluxes = long(_num_FSRs) * _num_groups;
+  long size = 2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  memcpy(_scalar_flux, fluxes, num_scalar_fluxes * sizeof(FP_PRECISION));
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < size; i++)
+    _boundary_flux_single[i] = fluxes[num_scalar_fluxes + i];
+}
+
+
+/**
+ * @brief Switches the boundary fluxes and stored exponentials to full
+ *        precision when the source residual nears the single precision
+ *        limit if adaptive precision is used.
+ * @details The boundary fluxes are converted to FP_PRECISION and the stored
+ *          exponentials are recomputed, unless single precision was
+ *          requested for them. The scalar fluxes and \f$ k_{eff} \f$ are
+ *          already in FP_PRECISION and carry over unchanged.
+ * @param residual the residual of the source on this iteration
+ * @return whether the precision was increased
+ */
+bool CPUSolver::increasePrecision(FP_PRECISION residual) {
+
+  if (!_reduced_precision ||
+      residual > ADAPTIVE_PRECISION_RESIDUAL * FLT_EPSILON)
+    return false;
+
+  log_printf(NORMAL, "Switching to full precision at a source residual "
+             "of %1.3E", residual);
+
+  _reduced_precision = false;
+
+  /* Convert the boundary fluxes to full precision */
+  if (_boundary_flux_single != NULL && !_single_boundary_flux) {
+
+    long size = 2 * long(_tot_num_tracks) * _polar_times_groups;
+    _boundary_flux = new FP_PRECISION[size];
+
+    #pragma omp parallel for schedule(guided)
+    for (long i=0; i < size; i++)
+      _boundary_flux[i] = _boundary_flux_single[i];
+
+    delete [] _boundary_flux_single;
+    _boundary_flux_single = NULL;
+  }
+
+  /* Recompute the stored exponentials in full precision */
+  if (_segment_exponentials_single != NULL && !_single_stored_exponentials)
+    initializeSegmentExponentials();
+
+  return true;
+}
+
+
+/**
+ * @brief Returns the machine epsilon of the precision in which the fluxes
+ *        are stored.
+ * @return the machine epsilon for the stored fluxes
+ */
+double CPUSolver::getFluxEpsilon() {
+
+  if (_boundary_flux_single != NULL)
+    return std::numeric_limits<float>::epsilon();
+  else
+    return Solver::getFluxEpsilon();
 }
 
 
@@ -437,16 +1692,53 @@ void CPUSolver::initializeCmfd() {
  * @brief Zero each Track's boundary fluxes for each energy group and polar
  *        angle in the "forward" and "reverse" directions.
  */
-void CPUSolver::zeroTrackFluxes() {
+void CPUSolver::zeroTrackFluxes() {
+
+  #pragma omp parallel for schedule(guided)
+  for (int t=0; t < _tot_num_tracks; t++) {
+    for (int d=0; d < 2; d++) {
+      for (int p=0; p < _num_polar; p++) {
+        for (int e=0; e < _num_groups; e++) {
+          if (_boundary_flux_single != NULL)
+            _boundary_flux_single(t,d,p,e) = 0.0;
+          else
+            _boundary_flux(t,d,p,e) = 0.0;
+        }
+      }
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * @brief Set the scalar flux for each FSR and energy group to some value.
+ * @param value the value to assign to each FSR scalar flux
+ */
+void CPUSolver::flattenFSRFluxes(FP_PRECISION value) {
+
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=0; e < _num_groups; e++)
+      _scalar_flux(r,e) = value;
+  }
+
+  return;
+}
+
+
+/**
+ * @brief Set each thread's private scalar flux to zero for each FSR and
+ *        energy group.
+ */
+void CPUSolver::zeroThreadFluxes() {
 
   #pragma omp parallel for schedule(guided)
-  for (int t=0; t < _tot_num_tracks; t++) {
-    for (int d=0; d < 2; d++) {
-      for (int p=0; p < _num_polar; p++) {
-        for (int e=0; e < _num_groups; e++) {
-          _boundary_flux(t,d,p,e) = 0.0;
-        }
-      }
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int t=0; t < _num_threads; t++) {
+      for (int e=0; e < _num_groups; e++)
+        _thread_flux(t,r,e) = 0.0;
     }
   }
 
@@ -455,15 +1747,18 @@ void CPUSolver::zeroTrackFluxes() {
 
 
 /**
- * @brief Set the scalar flux for each FSR and energy group to some value.
- * @param value the value to assign to each FSR scalar flux
+ * @brief Reduces the thread-private scalar fluxes into the FSR scalar flux.
+ * @details Each thread reduces the private fluxes for a subset of the FSRs
+ *          such that no two threads write to the same FSR scalar flux.
  */
-void CPUSolver::flattenFSRFluxes(FP_PRECISION value) {
+void CPUSolver::reduceThreadFluxes() {
 
   #pragma omp parallel for schedule(guided)
   for (int r=0; r < _num_FSRs; r++) {
-    for (int e=0; e < _num_groups; e++)
-      _scalar_flux(r,e) = value;
+    for (int t=0; t < _num_threads; t++) {
+      for (int e=0; e < _num_groups; e++)
+        _scalar_flux(r,e) += _thread_flux(t,r,e);
+    }
   }
 
   return;
@@ -473,6 +1768,8 @@ void CPUSolver::flattenFSRFluxes(FP_PRECISION value) {
  /**
   * @brief Set the Cmfd Mesh surface currents for each Mesh cell and energy
   *        group to zero.
+  * @details This zeroes both the shared and the thread-private surface
+  *          currents.
   */
 void CPUSolver::zeroSurfaceCurrents() {
 
@@ -481,6 +1778,37 @@ void CPUSolver::zeroSurfaceCurrents() {
     for (int s=0; s < 8; s++) {
       for (int e=0; e < _num_groups; e++)
         _surface_currents(r*8+s,e) = 0.0;
+
+      for (int t=0; t < _num_threads; t++) {
+        for (int e=0; e < _num_cmfd_groups; e++)
+          _thread_currents(t,r*8+s,e) = 0.0;
+      }
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * @brief Reduces the thread-private surface currents into the Cmfd Mesh
+ *        surface currents.
+ * @details Each thread reduces the private currents for a subset of the
+ *          Mesh cells such that no two threads write to the same surface.
+ */
+void CPUSolver::reduceThreadCurrents() {
+
+  int index;
+
+  #pragma omp parallel for private(index) schedule(guided)
+  for (int r=0; r < _num_mesh_cells; r++) {
+    for (int s=0; s < 8; s++) {
+      for (int t=0; t < _num_threads; t++) {
+        for (int e=0; e < _num_cmfd_groups; e++) {
+          index = (r*8+s) * _num_cmfd_groups + e;
+          _surface_currents[index] += _thread_currents(t,r*8+s,e);
+        }
+      }
     }
   }
 
@@ -552,7 +1880,10 @@ void CPUSolver::normalizeFluxes() {
     for (int j=0; j < 2; j++) {
       for (int p=0; p < _num_polar; p++) {
         for (int e=0; e < _num_groups; e++) {
-          _boundary_flux(i,j,p,e) *= norm_factor;
+          if (_boundary_flux_single != NULL)
+            _boundary_flux_single(i,j,p,e) *= norm_factor;
+          else
+            _boundary_flux(i,j,p,e) *= norm_factor;
         }
       }
     }
@@ -576,6 +1907,9 @@ void CPUSolver::normalizeFluxes() {
  */
 FP_PRECISION CPUSolver::computeFSRSources() {
 
+  if (_source_update_type == MATERIAL_BLOCK_SOURCES)
+    return computeMaterialBlockSources();
+
   int tid;
   Material* material;
   FP_PRECISION scatter_source;
@@ -584,6 +1918,8 @@ FP_PRECISION CPUSolver::computeFSRSources() {
   FP_PRECISION* sigma_s;
   FP_PRECISION* sigma_t;
   FP_PRECISION* chi;
+  int* sigma_s_begin;
+  int* sigma_s_end;
 
   FP_PRECISION source_residual = 0.0;
 
@@ -591,7 +1927,8 @@ FP_PRECISION CPUSolver::computeFSRSources() {
 
   /* For all FSRs, find the source */
   #pragma omp parallel for private(tid, material, nu_sigma_f, chi, \
-    sigma_s, sigma_t, fission_source, scatter_source) schedule(guided)
+    sigma_s, sigma_t, sigma_s_begin, sigma_s_end, fission_source, \
+    scatter_source) schedule(guided)
   for (int r=0; r < _num_FSRs; r++) {
 
     tid = omp_get_thread_num();
@@ -600,6 +1937,8 @@ FP_PRECISION CPUSolver::computeFSRSources() {
     chi = material->getChi();
     sigma_s = material->getSigmaS();
     sigma_t = material->getSigmaT();
+    sigma_s_begin = material->getSigmaSBegin();
+    sigma_s_end = material->getSigmaSEnd();
 
     /* Initialize the source residual to zero */
     _source_residuals[r] = 0.;
@@ -617,16 +1956,18 @@ FP_PRECISION CPUSolver::computeFSRSources() {
     else
       fission_source = 0.0;
 
-    /* Compute total scattering source for group G */
+    /* Compute total scattering source for group G from only those
+     * origin groups in the band of non-zero scattering cross-sections */
     for (int G=0; G < _num_groups; G++) {
-      scatter_source = 0;
+      int begin = sigma_s_begin[G];
+      int end = sigma_s_end[G];
+      FP_PRECISION* sigma_s_G = &sigma_s[G*_num_groups];
 
-      for (int g=0; g < _num_groups; g++)
-        _scatter_sources(tid,g) = material->getSigmaSByGroupInline(g,G)
-                      * _scalar_flux(r,g);
+      for (int g=begin; g < end; g++)
+        _scatter_sources(tid,g) = sigma_s_G[g] * _scalar_flux(r,g);
 
-        scatter_source=pairwise_sum<FP_PRECISION>(&_scatter_sources(tid,0),
-                                                   _num_groups);
+      scatter_source = pairwise_sum<FP_PRECISION>(&_scatter_sources(tid,begin),
+                                                  end - begin);
 
       /* Set the total source for FSR r in group G */
       _source(r,G) = (fission_source * chi[G] + scatter_source) *
@@ -652,6 +1993,126 @@ FP_PRECISION CPUSolver::computeFSRSources() {
 }
 
 
+/**
+ * @brief Computes the total source (fission and scattering) in each FSR
+ *        for blocks of FSRs which share a Material.
+ * @details This method computes the same sources and residual as the
+ *          FSR-by-FSR algorithm in CPUSolver::computeFSRSources(). The
+ *          scalar fluxes for each block of FSRs are gathered into a
+ *          [groups x FSRs] array so that the fission and scattering sources
+ *          are products of the Material's cross-sections with the block's
+ *          fluxes, where each cross-section is loaded once and applied to
+ *          all FSRs in the block with unit-stride vector operations. The
+ *          reduced sources use the precomputed inverse total cross-sections.
+ * @return the residual between this source and the previous source
+ */
+FP_PRECISION CPUSolver::computeMaterialBlockSources() {
+
+  FP_PRECISION inverse_k_eff = 1.0 / _k_eff;
+
+  int block_size = _num_groups * SOURCE_BLOCK_SIZE;
+
+  /* Loop over all blocks of FSRs which share a Material */
+  #pragma omp parallel for schedule(guided)
+  for (int b=0; b < _num_source_blocks; b++) {
+
+    int tid = omp_get_thread_num();
+    int min_FSR = _source_block_offsets[b];
+    int num_FSRs = _source_block_offsets[b+1] - min_FSR;
+    int* FSR_ids = &_material_FSRs[min_FSR];
+
+    int m = _source_block_materials[b];
+    Material* material = _materials[m];
+    FP_PRECISION* nu_sigma_f = material->getNuSigmaF();
+    FP_PRECISION* chi = material->getChi();
+    FP_PRECISION* sigma_s = material->getSigmaS();
+    int* sigma_s_begin = material->getSigmaSBegin();
+    int* sigma_s_end = material->getSigmaSEnd();
+    FP_PRECISION* inverse_sigma_t = &_inverse_sigma_t[m*_num_groups];
+
+    FP_PRECISION* block_flux =
+         &_source_block_arrays[tid * _source_block_stride];
+    FP_PRECISION* block_source = &block_flux[block_size];
+    FP_PRECISION* fission_source = &block_source[block_size];
+    FP_PRECISION* scatter_source = &fission_source[SOURCE_BLOCK_SIZE];
+
+    /* Gather the scalar fluxes into a [groups x FSRs] array */
+    for (int i=0; i < num_FSRs; i++) {
+      for (int g=0; g < _num_groups; g++)
+        block_flux[g*SOURCE_BLOCK_SIZE+i] = _scalar_flux(FSR_ids[i],g);
+    }
+
+    /* Compute the fission source in each FSR */
+    for (int i=0; i < num_FSRs; i++)
+      fission_source[i] = 0.;
+
+    if (material->isFissionable()) {
+      for (int g=0; g < _num_groups; g++) {
+        FP_PRECISION* flux = &block_flux[g*SOURCE_BLOCK_SIZE];
+
+        #pragma simd
+        for (int i=0; i < num_FSRs; i++)
+          fission_source[i] += nu_sigma_f[g] * flux[i];
+      }
+
+      for (int i=0; i < num_FSRs; i++)
+        fission_source[i] *= inverse_k_eff;
+    }
+
+    /* Compute the total source for each group G from the origin groups in
+     * the band of non-zero scattering cross-sections */
+    for (int G=0; G < _num_groups; G++) {
+      FP_PRECISION* sigma_s_G = &sigma_s[G*_num_groups];
+      FP_PRECISION* source = &block_source[G*SOURCE_BLOCK_SIZE];
+
+      for (int i=0; i < num_FSRs; i++)
+        scatter_source[i] = 0.;
+
+      for (int g=sigma_s_begin[G]; g < sigma_s_end[G]; g++) {
+        FP_PRECISION* flux = &block_flux[g*SOURCE_BLOCK_SIZE];
+
+        #pragma simd
+        for (int i=0; i < num_FSRs; i++)
+          scatter_source[i] += sigma_s_G[g] * flux[i];
+      }
+
+      #pragma simd
+      for (int i=0; i < num_FSRs; i++)
+        source[i] = (fission_source[i] * chi[G] + scatter_source[i]) *
+                    ONE_OVER_FOUR_PI;
+    }
+
+    /* Scatter the sources back to each FSR and compute the residuals */
+    for (int i=0; i < num_FSRs; i++) {
+      int r = FSR_ids[i];
+      FP_PRECISION residual = 0.;
+
+      #pragma simd reduction(+:residual)
+      for (int G=0; G < _num_groups; G++) {
+        FP_PRECISION source = block_source[G*SOURCE_BLOCK_SIZE+i];
+        FP_PRECISION delta = (source - _old_source(r,G)) / source;
+
+        /* Only include sources which are non-zero in the residual */
+        residual += (fabs(source) > 1E-10) ? delta * delta : 0.;
+
+        _source(r,G) = source;
+        _reduced_source(r,G) = source * inverse_sigma_t[G];
+        _old_source(r,G) = source;
+      }
+
+      _source_residuals[r] = residual;
+    }
+  }
+
+  /* Sum up the residuals from each FSR */
+  FP_PRECISION source_residual =
+       pairwise_sum<FP_PRECISION>(_source_residuals, _num_FSRs);
+  source_residual = sqrt(source_residual / (_num_FSRs * _num_groups));
+
+  return source_residual;
+}
+
+
 /**
  * @brief Compute \f$ k_{eff} \f$ from the total fission and absorption rates.
  * @details This method computes the current approximation to the
@@ -739,240 +2200,538 @@ void CPUSolver::computeKeff() {
  */
 void CPUSolver::transportSweep() {
 
-  int tid;
-  int min_track, max_track;
-  Track* curr_track;
-  int azim_index;
-  int num_segments;
-  segment* curr_segment;
-  segment* segments;
-  FP_PRECISION* track_flux;
-
   log_printf(DEBUG, "Transport sweep with %d OpenMP threads", _num_threads);
 
+  /* Sweep the blocks of energy groups in Gauss-Seidel order */
+  if (_group_block_offsets != NULL) {
+
+    int num_blocks = std::min(_num_group_blocks, _num_groups);
+
+    for (int b=0; b < num_blocks; b++)
+      sweepGroupBlock(b);
+
+    /* Sweep the blocks with upscattering sources again */
+    for (int i=0; i < _num_upscatter_iterations; i++) {
+      for (int b=_first_upscatter_block; b < num_blocks; b++)
+        sweepGroupBlock(b);
+    }
+
+    /* Each block is swept over all Tracks */
+    _num_track_passes = num_blocks + _num_upscatter_iterations *
+                        (num_blocks - _first_upscatter_block);
+
+    return;
+  }
+
+  _num_track_passes = 1;
+
   /* Initialize flux in each FSr to zero */
   flattenFSRFluxes(0.0);
 
+  if (_flux_tally_type == THREAD_PRIVATE)
+    zeroThreadFluxes();
+
   if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
     zeroSurfaceCurrents();
 
+  sweepTracks(0, _num_groups);
+
+  /* Reduce the thread-private fluxes into the FSR scalar fluxes */
+  if (_flux_tally_type == THREAD_PRIVATE)
+    reduceThreadFluxes();
+
+  /* Reduce the thread-private currents into the surface currents */
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    reduceThreadCurrents();
+
+  return;
+}
+
+
+/**
+ * @brief Sweeps all Tracks for a range of energy groups and tallies the
+ *        FSR scalar fluxes.
+ * @details The Tracks in each azimuthal angle halfspace are swept in
+ *          parallel, one color at a time if the Tracks are colored. All
+ *          energy groups are swept with CPUSolver::sweepTrackKernel(...),
+ *          and other ranges with CPUSolver::sweepTrackGroups(...), both of
+ *          which are selected for the problem size.
+ * @param group_begin the first energy group to sweep
+ * @param group_end one past the last energy group to sweep
+ */
+void CPUSolver::sweepTracks(int group_begin, int group_end) {
+
+  int track_id;
+  int min_track, max_track;
+  int num_batches;
+  int* num_colors = NULL;
+  int* color_offsets = NULL;
+  int* color_tracks = NULL;
+  bool all_groups = (group_begin == 0 && group_end == _num_groups);
+
+  /* Allocate a temporary FSR flux buffer for each thread, each of which
+   * is padded to a multiple of the cache line size. The FSR flux for each
+   * group is followed by space for the exponentials for each polar angle
+   * and group, and for the Track's angular flux if the boundary fluxes are
+   * stored in single precision. */
+  FP_PRECISION* thread_fsr_flux;
+  int fsr_flux_stride = ((_num_groups + 2 * _polar_times_groups) *
+                         sizeof(FP_PRECISION) + 63) / 64 * 64 /
+                        sizeof(FP_PRECISION);
+  FP_PRECISION* fsr_fluxes = new FP_PRECISION[_num_threads * fsr_flux_stride];
+
+#ifdef SWEEP_COUNTERS
+  double start;
+
+  if (_num_counter_threads != _num_threads)
+    initializeSweepCounters();
+
+  readHardwareCounters(-1.);
+#endif
+
+  if (_flux_tally_type == TRACK_COLORING) {
+    num_colors = _track_generator->getNumColorsArray();
+    color_offsets = _track_generator->getColorOffsets();
+    color_tracks = _track_generator->getColorTracks();
+  }
+
   /* Loop over azimuthal angle halfspaces */
   for (int i=0; i < 2; i++) {
 
-    /* Compute the minimum and maximum Track IDs corresponding to
-     * this azimuthal angular halfspace */
-    min_track = i * (_tot_num_tracks / 2);
-    max_track = (i + 1) * (_tot_num_tracks / 2);
-
-    /* Loop over each thread within this azimuthal angle halfspace */
-    #pragma omp parallel for private(curr_track, azim_index, num_segments, \
-      curr_segment, segments, track_flux, tid) schedule(guided)
-    for (int track_id=min_track; track_id < max_track; track_id++) {
-
-      tid = omp_get_thread_num();
-
-      /* Use local array accumulator to prevent false sharing*/
-      FP_PRECISION* thread_fsr_flux;
-      thread_fsr_flux = new FP_PRECISION[_num_groups];
-
-      /* Initialize local pointers to important data structures */
-      curr_track = _tracks[track_id];
-      azim_index = curr_track->getAzimAngleIndex();
-      num_segments = curr_track->getNumSegments();
-      segments = curr_track->getSegments();
-      track_flux = &_boundary_flux(track_id,0,0,0);
-
-      /* Loop over each Track segment in forward direction */
-      for (int s=0; s < num_segments; s++) {
-        curr_segment = &segments[s];
-        scalarFluxTally(curr_segment, azim_index, track_flux,
-                        thread_fsr_flux,true);
-      }
-
-      /* Transfer boundary angular flux to outgoing Track */
-      transferBoundaryFlux(track_id, azim_index, true, track_flux);
+    /* Sweep the Tracks in this halfspace one color at a time, or as a
+     * single batch if the Tracks are not colored */
+    if (_flux_tally_type == TRACK_COLORING)
+      num_batches = num_colors[i];
+    else
+      num_batches = 1;
 
-      /* Loop over each Track segment in reverse direction */
-      track_flux += _polar_times_groups;
+    for (int b=0; b < num_batches; b++) {
 
-      for (int s=num_segments-1; s > -1; s--) {
-        curr_segment = &segments[s];
-        scalarFluxTally(curr_segment, azim_index, track_flux,
-                        thread_fsr_flux,false);
+      /* Compute the minimum and maximum indices of the Tracks in this batch */
+      if (_flux_tally_type == TRACK_COLORING) {
+        min_track = color_offsets[i*num_colors[0] + b];
+        max_track = color_offsets[i*num_colors[0] + b + 1];
+      }
+      else {
+        min_track = i * (_tot_num_tracks / 2);
+        max_track = (i + 1) * (_tot_num_tracks / 2);
       }
-      delete thread_fsr_flux;
 
-      /* Transfer boundary angular flux to outgoing Track */
-      transferBoundaryFlux(track_id, azim_index, false, track_flux);
+      /* Loop over each Track within this batch */
+#ifdef SWEEP_COUNTERS
+      #pragma omp parallel for private(track_id, thread_fsr_flux, start) \
+        schedule(guided)
+#else
+      #pragma omp parallel for private(track_id, thread_fsr_flux) \
+        schedule(guided)
+#endif
+      for (int t=min_track; t < max_track; t++) {
+
+        if (_flux_tally_type == TRACK_COLORING)
+          track_id = color_tracks[t];
+        else
+          track_id = t;
+
+#ifdef SWEEP_COUNTERS
+        start = omp_get_wtime();
+#endif
+
+        /* Use local array accumulator to prevent false sharing*/
+        thread_fsr_flux = &fsr_fluxes[omp_get_thread_num() * fsr_flux_stride];
+
+        /* Sweep the Track with the kernel for this problem size */
+        if (all_groups)
+          (this->*_sweep_track)(track_id, thread_fsr_flux);
+        else
+          (this->*_sweep_track_groups)(track_id, thread_fsr_flux,
+                                       group_begin, group_end);
+
+#ifdef SWEEP_COUNTERS
+        countTrackSweep(track_id, group_end - group_begin,
+                        omp_get_wtime() - start);
+#endif
+      }
     }
   }
 
-  return;
+#ifdef SWEEP_COUNTERS
+  readHardwareCounters(1.);
+#endif
+
+  delete [] fsr_fluxes;
+}
+
+
+/**
+ * @brief Sweeps one block of energy groups for the Gauss-Seidel sweep.
+ * @details The block's scalar fluxes are swept with the sources computed
+ *          at the start of the transport sweep, except for the scattering
+ *          from the blocks already swept. The source term is then added to
+ *          them, and the scattering from the block to the groups which are
+ *          swept after it is updated with its new scalar fluxes. The fission
+ *          source is not updated until the next source iteration.
+ * @param block the index of the energy group block
+ */
+void CPUSolver::sweepGroupBlock(int block) {
+
+  int group_begin = _group_block_offsets[block];
+  int group_end = _group_block_offsets[block+1];
+
+  /* The sources of the slower groups use this block's scalar fluxes, and so
+   * do those of the groups with upscattering if they are swept again */
+  int source_begin = group_end;
+
+  if (_num_upscatter_iterations > 0)
+    source_begin = std::min(source_begin,
+                            _group_block_offsets[_first_upscatter_block]);
+
+  /* Remove the scattering from the block's previous scalar fluxes */
+  updateScatterSources(group_begin, group_end, source_begin, -1.0);
+
+  /* Initialize the block's flux in each FSR to zero */
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+    for (int e=group_begin; e < group_end; e++)
+      _scalar_flux(r,e) = 0.0;
+  }
+
+  if (_flux_tally_type == THREAD_PRIVATE)
+    zeroThreadFluxes();
+
+  sweepTracks(group_begin, group_end);
+
+  if (_flux_tally_type == THREAD_PRIVATE)
+    reduceThreadFluxes();
+
+  addSourceToGroupBlock(group_begin, group_end);
+
+  /* Add the scattering from the block's new scalar fluxes */
+  updateScatterSources(group_begin, group_end, source_begin, 1.0);
+}
+
+
+/**
+ * @brief Sweeps a Track in the forward and reverse directions for all
+ *        energy groups with a kernel specialized for the number of energy
+ *        groups and polar angles.
+ * @param track_id the ID of the Track to sweep
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ */
+template <int NUM_GROUPS, int NUM_POLAR>
+void CPUSolver::sweepTrackKernel(int track_id, FP_PRECISION* fsr_flux) {
+  sweepTrackGroups<NUM_GROUPS, NUM_POLAR>(track_id, fsr_flux, 0,
+       (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups);
+}
+
+
+/**
+ * @brief Sweeps a Track in the forward and reverse directions for a range
+ *        of energy groups with a kernel specialized for the number of energy
+ *        groups and polar angles.
+ * @details A template parameter of zero uses the number of energy groups or
+ *          polar angles given at runtime. Otherwise, the loops over energy
+ *          groups and polar angles have a fixed trip count, and the Track's
+ *          angular flux and the FSR flux buffer are held in local arrays
+ *          which the compiler may keep in registers. The Gauss-Seidel sweep
+ *          uses the same kernel for each block of energy groups.
+ * @param track_id the ID of the Track to sweep
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ * @param group_begin the first energy group to sweep
+ * @param group_end one past the last energy group to sweep
+ */
+template <int NUM_GROUPS, int NUM_POLAR>
+void CPUSolver::sweepTrackGroups(int track_id, FP_PRECISION* fsr_flux,
+                                 int group_begin, int group_end) {
+
+  const bool fixed_size = (NUM_GROUPS > 0 && NUM_POLAR > 0);
+  const int num_fluxes = fixed_size ? NUM_GROUPS * NUM_POLAR : 1;
+  const int num_groups = (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups;
+  const int size = fixed_size ? num_fluxes : _polar_times_groups;
+
+  int azim_index = _tracks[track_id]->getAzimAngleIndex();
+  int min_segment = _segment_offsets[track_id];
+  int max_segment = _segment_offsets[track_id+1];
+
+  /* The Track's angular flux in the boundary flux array, or in the single
+   * precision array */
+  const bool single = (_boundary_flux_single != NULL);
+  FP_PRECISION* track_flux = NULL;
+  float* track_flux_single = NULL;
+
+  if (single)
+    track_flux_single = &_boundary_flux_single(track_id,0,0,0);
+  else
+    track_flux = &_boundary_flux(track_id,0,0,0);
+
+  /* The generic kernel sweeps the Track's angular flux in place unless it
+   * is stored in single precision, and otherwise sweeps a copy which
+   * follows the FSR flux and the exponentials in the thread's buffer */
+  const bool in_place = !fixed_size && !single;
+
+  /* Local copies of the Track's angular flux and the FSR flux buffer */
+  FP_PRECISION local_track_flux[num_fluxes];
+  FP_PRECISION local_fsr_flux[fixed_size ? NUM_GROUPS : 1];
+  FP_PRECISION* psi = fixed_size ? local_track_flux
+                                 : &fsr_flux[num_groups + _polar_times_groups];
+  FP_PRECISION* tally = fixed_size ? local_fsr_flux : fsr_flux;
+
+  /* Loop over the forward and reverse directions */
+  for (int d=0; d < 2; d++) {
+
+    bool fwd = (d == 0);
+
+    /* Load the Track's incoming angular flux */
+    if (in_place)
+      psi = track_flux;
+    else if (single) {
+      for (int i=0; i < size; i++)
+        psi[i] = track_flux_single[i];
+    }
+    else {
+      for (int i=0; i < size; i++)
+        psi[i] = track_flux[i];
+    }
+
+    /* Loop over each Track segment in this direction */
+    if (fwd) {
+      for (int s=min_segment; s < max_segment; s++)
+        scalarFluxTallyKernel<NUM_GROUPS, NUM_POLAR>(s, azim_index, psi,
+                                                     tally, fwd, group_begin,
+                                                     group_end);
+    }
+    else {
+      for (int s=max_segment-1; s >= min_segment; s--)
+        scalarFluxTallyKernel<NUM_GROUPS, NUM_POLAR>(s, azim_index, psi,
+                                                     tally, fwd, group_begin,
+                                                     group_end);
+    }
+
+    if (!in_place && !single) {
+      for (int i=0; i < size; i++)
+        track_flux[i] = psi[i];
+    }
+
+    /* Transfer boundary angular flux to outgoing Track */
+    transferBoundaryFluxKernel<NUM_GROUPS, NUM_POLAR>(track_id, azim_index,
+                                                      fwd, psi, group_begin,
+                                                      group_end);
+
+    if (single)
+      track_flux_single += _polar_times_groups;
+    else
+      track_flux += _polar_times_groups;
+  }
 }
 
 
 /**
- * @brief Computes the contribution to the FSR scalar flux from a Track segment.
- * @details This method integrates the angular flux for a Track segment across
- *          energy groups and polar angles, and tallies it into the FSR
- *          scalar flux, and updates the Track's angular flux.
- * @param curr_segment a pointer to the Track segment of interest
- * @param azim_index a pointer to the azimuthal angle index for this segment
+ * @brief Computes the contribution to the FSR scalar flux from a Track
+ *        segment for a fixed or runtime number of energy groups and polar
+ *        angles.
+ * @details A template parameter of zero uses the number of energy groups or
+ *          polar angles given at runtime. Only the energy groups from
+ *          group_begin to group_end are swept.
+ * @param segment_id the index of the Track segment in the segment arrays
+ * @param azim_index the azimuthal angle index for this segment
  * @param track_flux a pointer to the Track's angular flux
  * @param fsr_flux a pointer to the temporary FSR flux buffer
- * @param fwd
+ * @param fwd the Track direction (forward - true, reverse - false)
+ * @param group_begin the first energy group to sweep
+ * @param group_end one past the last energy group to sweep
  */
-void CPUSolver::scalarFluxTally(segment* curr_segment,
-                                int azim_index,
-                                FP_PRECISION* track_flux,
-                                FP_PRECISION* fsr_flux,
-                                bool fwd){
+template <int NUM_GROUPS, int NUM_POLAR>
+inline void CPUSolver::scalarFluxTallyKernel(int segment_id, int azim_index,
+                                             FP_PRECISION* track_flux,
+                                             FP_PRECISION* fsr_flux,
+                                             bool fwd, int group_begin,
+                                             int group_end) {
+
+  const bool fixed_size = (NUM_GROUPS > 0 && NUM_POLAR > 0);
+  const int num_groups = (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups;
+  const int num_polar = (NUM_POLAR > 0) ? NUM_POLAR : _num_polar;
 
   int tid = omp_get_thread_num();
-  int fsr_id = curr_segment->_region_id;
-  FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  int fsr_id = _segment_FSR_ids[segment_id];
+  FP_PRECISION length = _segment_lengths[segment_id];
+  FP_PRECISION* sigma_t =
+      _materials[_segment_material_uids[segment_id]]->getSigmaT();
+  FP_PRECISION* reduced_source = &_reduced_source(fsr_id,0);
+  FP_PRECISION* polar_weights = &_polar_weights(azim_index,0);
 
   /* The change in angular flux along this Track segment in the FSR */
   FP_PRECISION delta_psi;
   FP_PRECISION exponential;
+  FP_PRECISION tau, tau_table, delta;
+  int index;
 
   /* Set the FSR scalar flux buffer to zero */
-  memset(fsr_flux, 0.0, _num_groups * sizeof(FP_PRECISION));
+  for (int e=group_begin; e < group_end; e++)
+    fsr_flux[e] = 0.0;
+
+  /* Read the stored exponentials for all polar angles and energy groups,
+   * and then tally the flux */
+  if (_segment_exponentials != NULL || _segment_exponentials_single != NULL) {
+
+    const int num_exponentials = num_polar * num_groups;
+
+    /* The exponentials for the groups from group_begin to group_end lie
+     * between these indices */
+    const int first = group_begin;
+    const int last = (num_polar - 1) * num_groups + group_end;
+
+    /* The exponentials follow the FSR flux in the thread's buffer unless
+     * the problem size is fixed */
+    FP_PRECISION local_exponentials[fixed_size ? num_exponentials : 1];
+    FP_PRECISION* exponentials = fixed_size ? local_exponentials
+                                            : &fsr_flux[num_groups];
+
+    /* Read the stored exponentials in place, or convert those stored in
+     * single precision */
+    if (_segment_exponentials != NULL)
+      exponentials = &_segment_exponentials[size_t(segment_id) *
+                                            num_exponentials];
+
+    else {
+      float* stored = &_segment_exponentials_single[size_t(segment_id) *
+                                                    num_exponentials];
+      #pragma simd
+      for (int i=first; i < last; i++)
+        exponentials[i] = stored[i];
+    }
 
-  /* Loop over energy groups */
-  for (int e=0; e < _num_groups; e++) {
+    for (int p=0; p < num_polar; p++) {
 
-    /* Loop over polar angles */
-    for (int p=0; p < _num_polar; p++){
-      exponential = computeExponential(sigma_t[e], length, p);
-      delta_psi = (track_flux(p,e)-_reduced_source(fsr_id,e))*exponential;
-      fsr_flux[e] += delta_psi * _polar_weights(azim_index,p);
-      track_flux(p,e) -= delta_psi;
+      #pragma simd
+      for (int e=group_begin; e < group_end; e++) {
+        delta_psi = (track_flux[p*num_groups + e] - reduced_source[e]) *
+                    exponentials[p*num_groups + e];
+        fsr_flux[e] += delta_psi * polar_weights[p];
+        track_flux[p*num_groups + e] -= delta_psi;
+      }
     }
   }
 
-  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()){
-    if (curr_segment->_cmfd_surface_fwd != -1 && fwd){
+  /* Evaluate each exponential with the interpolation table or exp(...) */
+  else {
 
-      int pe = 0;
+    /* Loop over energy groups */
+    for (int e=group_begin; e < group_end; e++) {
 
-      /* Atomically increment the Cmfd Mesh surface current from the
-       * temporary array using mutual exclusion locks */
-      omp_set_lock(&_cmfd_surface_locks[curr_segment->_cmfd_surface_fwd]);
+      tau = sigma_t[e] * length;
 
-      /* Loop over energy groups */
-      for (int e = 0; e < _num_groups; e++) {
+      /* Find the nearest point in the interpolation table */
+      tau_table = std::min(tau, _exp_table_max_tau);
+      index = round_to_int(tau_table * _inverse_exp_table_spacing);
+      delta = tau_table - index * _exp_table_spacing;
 
-        /* Loop over polar angles */
-        for (int p = 0; p < _num_polar; p++){
+      /* Loop over polar angles */
+      for (int p=0; p < num_polar; p++){
 
-          /* Increment current (polar and azimuthal weighted flux, group) */
-          _surface_currents(curr_segment->_cmfd_surface_fwd,e) +=
-              track_flux(p,e)*_polar_weights(azim_index,p)/2.0;
-          pe++;
-        }
-      }
+        /* Evaluate the exponential using the interpolation table */
+        if (_interpolate_exponential)
+          exponential = interpolateExponential(index, p, delta);
 
-      /* Release Cmfd Mesh surface mutual exclusion lock */
-      omp_unset_lock(&_cmfd_surface_locks[curr_segment->_cmfd_surface_fwd]);
+        /* Evalute the exponential using the intrinsic exp(...) function */
+        else
+          exponential = 1.0 - exp(- tau / _quad->getSinTheta(p));
 
+        delta_psi = (track_flux[p*num_groups + e] - reduced_source[e]) *
+                    exponential;
+        fsr_flux[e] += delta_psi * polar_weights[p];
+        track_flux[p*num_groups + e] -= delta_psi;
+      }
     }
-    else if (curr_segment->_cmfd_surface_bwd != -1 && !fwd){
+  }
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()){
 
-      int pe = 0;
+    int surface = -1;
 
-      /* Atomically increment the Cmfd Mesh surface current from the
-       * temporary array using mutual exclusion locks */
-      omp_set_lock(&_cmfd_surface_locks[curr_segment->_cmfd_surface_bwd]);
+    if (fwd)
+      surface = _segment_cmfd_surfaces_fwd[segment_id];
+    else
+      surface = _segment_cmfd_surfaces_bwd[segment_id];
+
+    /* Increment this thread's private Cmfd Mesh surface current without
+     * locks - the currents are reduced at the end of the transport sweep */
+    if (surface != -1) {
+
+      int cmfd_group;
 
       /* Loop over energy groups */
-      for (int e = 0; e < _num_groups; e++) {
+      for (int e=group_begin; e < group_end; e++) {
+
+        cmfd_group = _cmfd->getCmfdGroup(e);
 
         /* Loop over polar angles */
-        for (int p = 0; p < _num_polar; p++){
+        for (int p = 0; p < num_polar; p++){
 
           /* Increment current (polar and azimuthal weighted flux, group) */
-          _surface_currents(curr_segment->_cmfd_surface_bwd,e) +=
-              track_flux(p,e)*_polar_weights(azim_index,p)/2.0;
-          pe++;
+          _thread_currents(tid,surface,cmfd_group) +=
+              track_flux[p*num_groups + e] * polar_weights[p] / 2.0;
         }
       }
 
-      /* Release Cmfd Mesh surface mutual exclusion lock */
-      omp_unset_lock(&_cmfd_surface_locks[curr_segment->_cmfd_surface_bwd]);
+#ifdef SWEEP_COUNTERS
+      _sweep_counters(tid, CMFD_CURRENT_TALLIES) +=
+           (group_end - group_begin) * num_polar;
+#endif
     }
   }
 
-  /* Atomically increment the FSR scalar flux from the temporary array */
-  omp_set_lock(&_FSR_locks[fsr_id]);
-  {
-    for (int e=0; e < _num_groups; e++)
-      _scalar_flux(fsr_id,e) += fsr_flux[e];
+  /* Increment this thread's private FSR scalar flux without locks */
+  if (_flux_tally_type == THREAD_PRIVATE) {
+    for (int e=group_begin; e < group_end; e++)
+      _thread_flux(tid,fsr_id,e) += fsr_flux[e];
   }
-  omp_unset_lock(&_FSR_locks[fsr_id]);
-
-  return;
-}
-
 
-/**
- * @brief Computes the exponential term in the transport equation for a
- *        Track segment.
- * @details This method computes \f$ 1 - exp(-l\Sigma^T_g/sin(\theta_p)) \f$
- *          for a segment with total group cross-section and for some polar
- *          angle. This method uses either a linear interpolation table
- *          (default) or the exponential intrinsic exp(...) function if
- *          requested by the user through a call to the
- *          Solver::useExponentialIntrinsic()  routine.
- * @param sigma_t the total group cross-section at this energy
- * @param length the length of the Track segment projected in the xy-plane
- * @param p the polar angle index
- * @return the evaluated exponential
- */
-FP_PRECISION CPUSolver::computeExponential(FP_PRECISION sigma_t,
-                                           FP_PRECISION length, int p) {
-
-  FP_PRECISION exponential;
-  FP_PRECISION tau = sigma_t * length;
-
-  /* Evaluate the exponential using the lookup table - linear interpolation */
-  if (_interpolate_exponential) {
-    int index;
-    index = round_to_int(tau * _inverse_exp_table_spacing);
-    index *= _two_times_num_polar;
-    exponential = (1. - (_exp_table[index+2 * p] * tau +
-                  _exp_table[index + 2 * p +1]));
+  /* Increment the FSR scalar flux without locks since no other Track of
+   * this color crosses this FSR */
+  else if (_flux_tally_type == TRACK_COLORING) {
+    for (int e=group_begin; e < group_end; e++)
+      _scalar_flux(fsr_id,e) += fsr_flux[e];
   }
 
-  /* Evalute the exponential using the intrinsic exp(...) function */
+  /* Atomically increment the FSR scalar flux from the temporary array */
   else {
-    FP_PRECISION sintheta = _quad->getSinTheta(p);
-    exponential = 1.0 - exp(- tau / sintheta);
+    setFSRLock(fsr_id);
+    {
+      for (int e=group_begin; e < group_end; e++)
+        _scalar_flux(fsr_id,e) += fsr_flux[e];
+    }
+    omp_unset_lock(&_FSR_locks[fsr_id]);
   }
-
-  return exponential;
 }
 
 
 /**
- * @brief Updates the boundary flux for a Track given boundary conditions.
- * @details For reflective boundary conditions, the outgoing boundary flux
- *          for the Track is given to the reflecting Track. For vacuum
- *          boundary conditions, the outgoing flux tallied as leakage.
+ * @brief Updates the boundary flux for a Track given boundary conditions
+ *        for a fixed or runtime number of energy groups and polar angles.
+ * @details A template parameter of zero uses the number of energy groups or
+ *          polar angles given at runtime.
  * @param track_id the ID number for the Track of interest
- * @param azim_index a pointer to the azimuthal angle index for this segment
+ * @param azim_index the azimuthal angle index for this Track
  * @param direction the Track direction (forward - true, reverse - false)
  * @param track_flux a pointer to the Track's outgoing angular flux
+ * @param group_begin the first energy group to transfer
+ * @param group_end one past the last energy group to transfer
  */
-void CPUSolver::transferBoundaryFlux(int track_id,
-                                     int azim_index,
-                                     bool direction,
-                                     FP_PRECISION* track_flux) {
+template <int NUM_GROUPS, int NUM_POLAR>
+inline void CPUSolver::transferBoundaryFluxKernel(int track_id,
+                                                  int azim_index,
+                                                  bool direction,
+                                                  FP_PRECISION* track_flux,
+                                                  int group_begin,
+                                                  int group_end) {
+
+  const int num_groups = (NUM_GROUPS > 0) ? NUM_GROUPS : _num_groups;
+  const int num_polar = (NUM_POLAR > 0) ? NUM_POLAR : _num_polar;
+
   int start;
   int bc;
   FP_PRECISION* track_leakage;
   int track_out_id;
+  FP_PRECISION* polar_weights = &_polar_weights(azim_index,0);
 
   /* Extract boundary conditions for this Track and the pointer to the
    * outgoing reflective Track, and index into the leakage array */
@@ -993,14 +2752,28 @@ void CPUSolver::transferBoundaryFlux(int track_id,
     track_out_id = _tracks[track_id]->getTrackIn()->getUid();
   }
 
-  FP_PRECISION* track_out_flux = &_boundary_flux(track_out_id,0,0,start);
-
   /* Loop over polar angles and energy groups */
-  for (int e=0; e < _num_groups; e++) {
-    for (int p=0; p < _num_polar; p++) {
-      track_out_flux(p,e) = track_flux(p,e) * bc;
-      track_leakage(p,e) = track_flux(p,e) *
-                            _polar_weights(azim_index,p) * (!bc);
+  for (int e=group_begin; e < group_end; e++) {
+    for (int p=0; p < num_polar; p++)
+      track_leakage[p*num_groups + e] = track_flux[p*num_groups + e] *
+                                        polar_weights[p] * (!bc);
+  }
+
+  /* Store the outgoing flux in the boundary flux array */
+  if (_boundary_flux_single != NULL) {
+    float* track_out_flux = &_boundary_flux_single(track_out_id,0,0,start);
+
+    for (int e=group_begin; e < group_end; e++) {
+      for (int p=0; p < num_polar; p++)
+        track_out_flux[p*num_groups + e] = track_flux[p*num_groups + e] * bc;
+    }
+  }
+  else {
+    FP_PRECISION* track_out_flux = &_boundary_flux(track_out_id,0,0,start);
+
+    for (int e=group_begin; e < group_end; e++) {
+      for (int p=0; p < num_polar; p++)
+        track_out_flux[p*num_groups + e] = track_flux[p*num_groups + e] * bc;
     }
   }
 }
@@ -1012,6 +2785,24 @@ void CPUSolver::transferBoundaryFlux(int track_id,
  */
 void CPUSolver::addSourceToScalarFlux() {
 
+  /* The Gauss-Seidel sweep adds the source to each block of groups */
+  if (_group_block_offsets != NULL)
+    return;
+
+  addSourceToGroupBlock(0, _num_groups);
+
+  return;
+}
+
+
+/**
+ * @brief Add the source term contribution in the transport equation to
+ *        the FSR scalar flux for a range of energy groups.
+ * @param group_begin the first energy group
+ * @param group_end one past the last energy group
+ */
+void CPUSolver::addSourceToGroupBlock(int group_begin, int group_end) {
+
   FP_PRECISION volume;
   FP_PRECISION* sigma_t;
 
@@ -1023,10 +2814,10 @@ void CPUSolver::addSourceToScalarFlux() {
     volume = _FSR_volumes[r];
     sigma_t = _FSR_materials[r]->getSigmaT();
 
-      for (int e=0; e < _num_groups; e++) {
-        _scalar_flux(r,e) *= 0.5;
-        _scalar_flux(r,e) = FOUR_PI * _reduced_source(r,e) +
-                            (_scalar_flux(r,e) / (sigma_t[e] * volume));
+    for (int e=group_begin; e < group_end; e++) {
+      _scalar_flux(r,e) *= 0.5;
+      _scalar_flux(r,e) = FOUR_PI * _reduced_source(r,e) +
+                          (_scalar_flux(r,e) / (sigma_t[e] * volume));
     }
   }
 
@@ -1034,6 +2825,57 @@ void CPUSolver::addSourceToScalarFlux() {
 }
 
 
+/**
+ * @brief Adds the scattering source from the scalar fluxes of a block of
+ *        energy groups to the sources of other energy groups.
+ * @details This is used by the Gauss-Seidel sweep to replace the scattering
+ *          from a block's scalar fluxes before it was swept with that from
+ *          its new scalar fluxes, in the sources of each group from
+ *          source_begin onwards outside of the block.
+ * @param group_begin the first energy group of the block
+ * @param group_end one past the last energy group of the block
+ * @param source_begin the first energy group whose source is updated
+ * @param weight the weight (+/-1) of the scattering source
+ */
+void CPUSolver::updateScatterSources(int group_begin, int group_end,
+                                     int source_begin, FP_PRECISION weight) {
+
+  #pragma omp parallel for schedule(guided)
+  for (int r=0; r < _num_FSRs; r++) {
+
+    Material* material = _FSR_materials[r];
+    FP_PRECISION* sigma_s = material->getSigmaS();
+    FP_PRECISION* sigma_t = material->getSigmaT();
+    int* sigma_s_begin = material->getSigmaSBegin();
+    int* sigma_s_end = material->getSigmaSEnd();
+
+    for (int G=source_begin; G < _num_groups; G++) {
+
+      /* Skip the groups in the block */
+      if (G >= group_begin && G < group_end)
+        continue;
+
+      /* Only the origin groups in the block and in the band of non-zero
+       * scattering cross-sections contribute */
+      int begin = std::max(sigma_s_begin[G], group_begin);
+      int end = std::min(sigma_s_end[G], group_end);
+
+      if (begin >= end)
+        continue;
+
+      FP_PRECISION* sigma_s_G = &sigma_s[G*_num_groups];
+      FP_PRECISION scatter_source = 0.;
+
+      for (int g=begin; g < end; g++)
+        scatter_source += sigma_s_G[g] * _scalar_flux(r,g);
+
+      _source(r,G) += weight * scatter_source * ONE_OVER_FOUR_PI;
+      _reduced_source(r,G) = _source(r,G) / sigma_t[G];
+    }
+  }
+}
+
+
 /**
  * @brief Computes the volume-weighted, energy integrated fission rate in
  *        each FSR and stores them in an array indexed by FSR ID.
@@ -1074,6 +2916,73 @@ void CPUSolver::computeFSRFissionRates(double* fission_rates, int num_FSRs) {
   return;
 }
 
+
+/**
+ * @brief Prints a report of the timing statistics to the console.
+ * @details In a build with the sweep counters (--with-counters), the report
+ *          is followed by the transport sweep counters summed over all
+ *          threads and a table of the work and FSR lock waits of each
+ *          thread, from which load imbalance and lock contention may be
+ *          seen.
+ */
+void CPUSolver::printTimerReport() {
+
+  Solver::printTimerReport();
+
+  if (_sweep_counters == NULL)
+    return;
+
+  std::string msg_string;
+  double totals[NUM_SWEEP_COUNTERS];
+
+  for (int c=0; c < NUM_SWEEP_COUNTERS; c++) {
+    totals[c] = 0.;
+
+    for (int t=0; t < _num_counter_threads; t++)
+      totals[c] += _sweep_counters(t,c);
+  }
+
+  log_printf(TITLE, "TRANSPORT SWEEP COUNTERS");
+
+  const char* names[NUM_SWEEP_COUNTERS] = {
+    "Segments swept", "Exponentials evaluated", "FSR lock acquisitions",
+    "FSR lock contentions", "FSR lock wait time (sec)",
+    "CMFD surface current tallies", "CPU cycles", "Last level cache misses"};
+
+  for (int c=0; c < NUM_SWEEP_COUNTERS; c++) {
+
+    /* Skip the hardware counters if they were not available */
+    if (c >= SWEEP_CYCLES &&
+        (_perf_event_fds == NULL || _perf_event_fds[0] == -1))
+      continue;
+
+    msg_string = names[c];
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%1.4E", msg_string.c_str(), totals[c]);
+  }
+
+  if (totals[FSR_LOCK_ACQUISITIONS] > 0.) {
+    msg_string = "FSR lock contention rate";
+    msg_string.resize(53, '.');
+    log_printf(RESULT, "%s%1.4E", msg_string.c_str(),
+               totals[FSR_LOCK_CONTENTIONS] / totals[FSR_LOCK_ACQUISITIONS]);
+  }
+
+  set_separator_character('-');
+  log_printf(SEPARATOR, "-");
+  log_printf(RESULT, "  thread      # segments     # lock waits    "
+             "lock wait (sec)");
+  log_printf(SEPARATOR, "-");
+
+  for (int t=0; t < _num_counter_threads; t++)
+    log_printf(RESULT, "%8d%16.4E%17.4E%19.4E", t,
+               _sweep_counters(t, SEGMENTS_SWEPT),
+               _sweep_counters(t, FSR_LOCK_CONTENTIONS),
+               _sweep_counters(t, FSR_LOCK_WAIT_TIME));
+
+  log_printf(SEPARATOR, "-");
+}
+
 /*
 void CPUSolver::updateBoundaryFlux(){
 
@@ -14,6 +14,16 @@
 #include <math.h>
 #include <omp.h>
 #include <stdlib.h>
+#include <float.h>
+#include <limits>
+#include <unistd.h>
+#ifdef SWEEP_COUNTERS
+#include <stdint.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+#endif
 #include "Solver.h"
 #endif
 
@@ -29,6 +39,145 @@
  *  for either the forward or reverse direction for a given Track */
 #define track_leakage(p,e) (track_leakage[(p)*_num_groups + (e)])
 
+/** Indexing macro for the thread-private scalar flux for each thread, FSR
+ *  and energy group */
+#define _thread_flux(t,r,e) (_thread_flux[(t)*_num_FSRs*_num_groups + (r)*_num_groups + (e)])
+
+/** Indexing macro for the thread-private surface currents for each thread,
+ *  CMFD Mesh surface and CMFD energy group */
+#define _thread_currents(t,s,e) (_thread_currents[((t)*_num_mesh_cells*8 + (s))*_num_cmfd_groups + (e)])
+
+/** Indexing macro for the Track boundary angular fluxes stored in single
+ *  precision for each Track, direction, polar angle and energy group */
+#define _boundary_flux_single(i,j,p,e) (_boundary_flux_single[(i)*2*_polar_times_groups + (j)*_polar_times_groups + (p)*_num_groups + (e)])
+
+/** Indexing macro for the transport sweep counters of each thread, which
+ *  are followed by the thread's histogram of Track sweep times */
+#define _sweep_counters(t,c) (_sweep_counters[(t)*(NUM_SWEEP_COUNTERS + NUM_TRACK_TIME_BINS) + (c)])
+
+
+/** The maximum number of FSRs of one Material in each block of the
+ *  material-batched source computation */
+#define SOURCE_BLOCK_SIZE 64
+
+
+/**
+ * @enum fluxTallyType
+ * @brief The algorithm used to tally FSR scalar fluxes in the transport sweep.
+ */
+enum fluxTallyType {
+  /** Atomic updates to the shared scalar flux with one OpenMP lock per FSR */
+  FSR_LOCKS,
+
+  /** Lock-free updates to thread-private scalar flux arrays which are
+   *  reduced into the shared scalar flux after each transport sweep */
+  THREAD_PRIVATE,
+
+  /** Plain updates to the shared scalar flux by sweeping one color of
+   *  Tracks with non-overlapping FSRs at a time */
+  TRACK_COLORING
+};
+
+
+/**
+ * @enum sourceUpdateType
+ * @brief The algorithm used to compute the FSR sources on each iteration.
+ */
+enum sourceUpdateType {
+  /** Compute the fission and scattering sources one FSR at a time */
+  FSR_SOURCES,
+
+  /** Compute the fission and scattering sources for blocks of FSRs which
+   *  share a Material as products of the Material's cross-sections with
+   *  the [FSRs x groups] scalar flux */
+  MATERIAL_BLOCK_SOURCES
+};
+
+
+/**
+ * @enum exponentialStorageType
+ * @brief Whether the exponentials for each Track segment are computed in
+ *        each transport sweep or stored once for all sweeps.
+ */
+enum exponentialStorageType {
+  /** Compute the exponentials for each segment in each transport sweep */
+  COMPUTE_EXPONENTIALS,
+
+  /** Compute the exponentials for each segment once and store them */
+  STORE_EXPONENTIALS,
+
+  /** Store the exponentials if they need less than a fraction of the
+   *  machine's physical memory, and compute them otherwise */
+  AUTO_STORE_EXPONENTIALS
+};
+
+
+/**
+ * @enum energySweepType
+ * @brief The order in which the energy groups are swept.
+ */
+enum energySweepType {
+  /** Sweep all energy groups together with the sources from the previous
+   *  source iteration (a Jacobi iteration in energy) */
+  ENERGY_JACOBI,
+
+  /** Sweep blocks of energy groups from fast to thermal, each with sources
+   *  updated with the scalar fluxes of the faster groups already swept (a
+   *  Gauss-Seidel iteration in energy) */
+  ENERGY_GAUSS_SEIDEL
+};
+
+
+/**
+ * @enum sweepCounterType
+ * @brief The quantities counted by each thread in the transport sweeps of a
+ *        build with the sweep counters (--with-counters).
+ */
+enum sweepCounterType {
+  /** The number of Track segments swept in either direction */
+  SEGMENTS_SWEPT,
+
+  /** The number of exponentials evaluated rather than read from storage */
+  EXPONENTIALS_EVALUATED,
+
+  /** The number of FSR lock acquisitions */
+  FSR_LOCK_ACQUISITIONS,
+
+  /** The number of FSR lock acquisitions which waited for another thread */
+  FSR_LOCK_CONTENTIONS,
+
+  /** The time spent waiting for the FSR locks (seconds) */
+  FSR_LOCK_WAIT_TIME,
+
+  /** The number of tallies to the thread-private CMFD surface currents */
+  CMFD_CURRENT_TALLIES,
+
+  /** The number of CPU cycles in the transport sweeps, if the hardware
+   *  performance counters are available */
+  SWEEP_CYCLES,
+
+  /** The number of last level cache misses in the transport sweeps, if the
+   *  hardware performance counters are available */
+  SWEEP_LLC_MISSES
+};
+
+
+/** The number of quantities counted by each thread in the transport sweeps */
+#define NUM_SWEEP_COUNTERS 8
+
+/** The number of bins in the histogram of Track sweep times. Bin i counts
+ *  the Tracks swept in [2^i, 2^(i+1)) nanoseconds, and the first and last
+ *  bins also count the faster and slower Tracks. */
+#define NUM_TRACK_TIME_BINS 32
+
+
+/** The fraction of physical memory which stored exponentials may use when
+ *  AUTO_STORE_EXPONENTIALS is selected */
+#define STORED_EXPONENTIALS_MEMORY_FRACTION 0.25
+
+/** The source residual, in units of the single precision machine epsilon,
+ *  below which adaptive precision switches to full precision */
+#define ADAPTIVE_PRECISION_RESIDUAL 100.
 
 
 /**
@@ -49,11 +198,117 @@ protected:
   /** The number of shared memory OpenMP threads */
   int _num_threads;
 
+  /** The algorithm used to tally FSR scalar fluxes (FSR_LOCKS,
+   *  THREAD_PRIVATE or TRACK_COLORING) */
+  fluxTallyType _flux_tally_type;
+
   /** OpenMP mutual exclusion locks for atomic FSR scalar flux updates */
   omp_lock_t* _FSR_locks;
 
-  /** OpenMP mutual exclusion locks for atomic surface current updates */
-  omp_lock_t* _cmfd_surface_locks;
+  /** The transport sweep counters and the histogram of Track sweep times
+   *  for each thread in a build with the sweep counters */
+  double* _sweep_counters;
+
+  /** The file descriptors of the CPU cycle and last level cache miss
+   *  hardware performance counters for each thread, or -1 if the counters
+   *  are not available */
+  int* _perf_event_fds;
+
+  /** The number of threads for which the sweep counters are allocated */
+  int _num_counter_threads;
+
+  /** Thread-private FSR scalar fluxes for lock-free flux tallies */
+  FP_PRECISION* _thread_flux;
+
+  /** The number of CMFD energy groups */
+  int _num_cmfd_groups;
+
+  /** Thread-private CMFD Mesh surface currents for lock-free tallies */
+  FP_PRECISION* _thread_currents;
+
+  /** The algorithm used to compute the FSR sources (FSR_SOURCES or
+   *  MATERIAL_BLOCK_SOURCES) */
+  sourceUpdateType _source_update_type;
+
+  /** The FSR IDs sorted by Material UID for material-batched sources */
+  int* _material_FSRs;
+
+  /** The number of blocks of FSRs for material-batched sources */
+  int _num_source_blocks;
+
+  /** The offset of each block of FSRs into the _material_FSRs array */
+  int* _source_block_offsets;
+
+  /** The UID of the Material shared by each block of FSRs */
+  int* _source_block_materials;
+
+  /** The inverse total cross-section for each Material UID and energy
+   *  group used to compute the reduced sources */
+  FP_PRECISION* _inverse_sigma_t;
+
+  /** Thread-private arrays for the fluxes and sources of a block of FSRs,
+   *  each of which is padded to a multiple of the cache line size */
+  FP_PRECISION* _source_block_arrays;
+
+  /** The stride between the source block arrays of each thread */
+  int _source_block_stride;
+
+  /** The inverse of the sine of each polar angle */
+  FP_PRECISION* _inverse_sin_thetas;
+
+  /** Whether the exponentials for each segment are stored */
+  exponentialStorageType _exponential_storage;
+
+  /** Whether or not to store the exponentials in single precision */
+  bool _single_stored_exponentials;
+
+  /** The exponentials for each segment, polar angle and energy group */
+  FP_PRECISION* _segment_exponentials;
+
+  /** The exponentials for each segment, polar angle and energy group
+   *  stored in single precision */
+  float* _segment_exponentials_single;
+
+  /** Whether or not to store the Track boundary fluxes in single
+   *  precision */
+  bool _single_boundary_flux;
+
+  /** The Track boundary angular fluxes stored in single precision, used in
+   *  place of the boundary flux array if requested */
+  float* _boundary_flux_single;
+
+  /** Whether to store the boundary fluxes and exponentials in single
+   *  precision until the source residual nears the single precision limit */
+  bool _adaptive_precision;
+
+  /** Whether the precision is currently reduced for adaptive precision */
+  bool _reduced_precision;
+
+  /** The order in which the energy groups are swept */
+  energySweepType _energy_sweep_type;
+
+  /** The number of blocks of energy groups for the Gauss-Seidel sweep */
+  int _num_group_blocks;
+
+  /** The number of extra sweeps of the blocks with upscattering sources on
+   *  each Gauss-Seidel sweep */
+  int _num_upscatter_iterations;
+
+  /** The first energy group of each block, followed by the number of groups,
+   *  if the energy groups are swept in Gauss-Seidel order */
+  int* _group_block_offsets;
+
+  /** The first block of energy groups with upscattering sources */
+  int _first_upscatter_block;
+
+  /** The Track sweep kernel selected for the number of energy groups and
+   *  polar angles by CPUSolver::initializeSweepKernels() */
+  void (CPUSolver::*_sweep_track)(int track_id, FP_PRECISION* fsr_flux);
+
+  /** The Track sweep for a range of energy groups with the selected sweep
+   *  kernel */
+  void (CPUSolver::*_sweep_track_groups)(int track_id, FP_PRECISION* fsr_flux,
+                                         int group_begin, int group_end);
 
   void initializeFluxArrays();
   void initializeSourceArrays();
@@ -61,55 +316,66 @@ protected:
   void buildExpInterpTable();
   void initializeFSRs();
   void initializeCmfd();
+  void initializeSweepKernels();
+  void initializeSourceBlocks();
+  void initializeGroupBlocks();
+  void initializeSegmentExponentials();
+  void initializeSweepCounters();
+  void clearSweepCounters();
+  void readHardwareCounters(double sign);
+  void countTrackSweep(int track_id, int num_groups, double time);
+  void setFSRLock(int fsr_id);
+
+  template <int NUM_GROUPS>
+  void selectSweepKernel();
+
+  void accelerateFluxes();
+  void getFluxes(FP_PRECISION* fluxes);
+  void setFluxes(FP_PRECISION* fluxes);
+  double getFluxEpsilon();
+  bool increasePrecision(FP_PRECISION residual);
 
   void zeroTrackFluxes();
   void flattenFSRFluxes(FP_PRECISION value);
+  void zeroThreadFluxes();
+  void reduceThreadFluxes();
+  void sweepTracks(int group_begin, int group_end);
+  void sweepGroupBlock(int block);
+  void updateScatterSources(int group_begin, int group_end,
+                            int source_begin, FP_PRECISION weight);
+  void addSourceToGroupBlock(int group_begin, int group_end);
   void zeroSurfaceCurrents();
+  void reduceThreadCurrents();
   void flattenFSRSources(FP_PRECISION value);
   void normalizeFluxes();
   FP_PRECISION computeFSRSources();
+  FP_PRECISION computeMaterialBlockSources();
 
-  /**
-   * @brief Computes the contribution to the FSR flux from a Track segment.
-   * @param curr_segment a pointer to the Track segment of interest
-   * @param azim_index a pointer to the azimuthal angle index for this segment
-   * @param track_flux a pointer to the Track's angular flux
-   * @param fsr_flux a pointer to the temporary FSR scalar flux buffer
-   * @param fwd
-   */
-  virtual void scalarFluxTally(segment* curr_segment, int azim_index,
-                               FP_PRECISION* track_flux, FP_PRECISION* fsr_flux,
-                               bool fwd);
-
-  /**
-   * @brief Updates the boundary flux for a Track given boundary conditions.
-   * @param track_id the ID number for the Track of interest
-   * @param azim_index a pointer to the azimuthal angle index for this segment
-   * @param direction the Track direction (forward - true, reverse - false)
-   * @param track_flux a pointer to the Track's outgoing angular flux
-   */
-  virtual void transferBoundaryFlux(int track_id, int azim_index,
-                                    bool direction,
-                                    FP_PRECISION* track_flux);
   void addSourceToScalarFlux();
   void computeKeff();
   void transportSweep();
   //void updateBoundaryFlux();
 
-  /**
-   * @brief Computes the exponential term in the transport equation for a
-   *        track segment.
-   * @details This method uses either a linear interpolation table (default)
-   *          or the exponential intrinsic exp(...) function if requested by
-   *          the user through a call to the Solver::useExponentialIntrinsic()
-   *          routine.
-   * @param sigma_t the total group cross-section at this energy
-   * @param length the length of the Track segment projected in the xy-plane
-   * @param p the polar angle index
-   * @return the evaluated exponential
-   */
-  virtual FP_PRECISION computeExponential(FP_PRECISION sigma_t,
-                                          FP_PRECISION length, int p);
+  template <class SOLVER>
+  void sweepTrack(int track_id, FP_PRECISION* fsr_flux);
+
+  template <int NUM_GROUPS, int NUM_POLAR>
+  void sweepTrackKernel(int track_id, FP_PRECISION* fsr_flux);
+
+  template <int NUM_GROUPS, int NUM_POLAR>
+  void sweepTrackGroups(int track_id, FP_PRECISION* fsr_flux,
+                        int group_begin, int group_end);
+
+  template <int NUM_GROUPS, int NUM_POLAR>
+  void scalarFluxTallyKernel(int segment_id, int azim_index,
+                             FP_PRECISION* track_flux,
+                             FP_PRECISION* fsr_flux, bool fwd,
+                             int group_begin, int group_end);
+
+  template <int NUM_GROUPS, int NUM_POLAR>
+  void transferBoundaryFluxKernel(int track_id, int azim_index,
+                                  bool direction, FP_PRECISION* track_flux,
+                                  int group_begin, int group_end);
 
 public:
   CPUSolver(Geometry* geometry=NULL, TrackGenerator* track_generator=NULL);
@@ -120,12 +386,101 @@ public:
   FP_PRECISION* getFSRScalarFluxes();
   FP_PRECISION getFSRSource(int fsr_id, int energy_group);
   FP_PRECISION* getSurfaceCurrents();
+  fluxTallyType getFluxTallyType();
+  double getFluxTallyMemory(fluxTallyType tally_type);
+  sourceUpdateType getSourceUpdateType();
+  exponentialStorageType getExponentialStorage();
+  energySweepType getEnergySweepType();
+  int getNumGroupBlocks();
+  int getNumUpscatterIterations();
+  bool isStoringExponentials();
+  bool isBoundaryFluxSinglePrecision();
+  bool isUsingAdaptivePrecision();
+  double getStoredExponentialsMemory();
+  void getSweepCounter(sweepCounterType counter, double* counts,
+                       int num_threads);
+  void getTrackTimeHistogram(double* histogram, int num_bins);
 
   void setNumThreads(int num_threads);
+  void setFluxTallyType(fluxTallyType tally_type);
+  void setSourceUpdateType(sourceUpdateType update_type);
+  void setExponentialStorage(exponentialStorageType storage_type);
+  void setEnergySweepType(energySweepType sweep_type);
+  void setNumGroupBlocks(int num_blocks);
+  void setNumUpscatterIterations(int num_iterations);
+  void setStoredExponentialsSinglePrecision(bool single_precision);
+  void setBoundaryFluxSinglePrecision(bool single_precision);
+  void setAdaptivePrecision(bool adaptive_precision);
 
   void computeFSRFissionRates(double* fission_rates, int num_FSRs);
+  void printTimerReport();
 
 };
 
 
+/**
+ * @brief Acquires the OpenMP lock of an FSR to tally its scalar flux.
+ * @details In a build with the sweep counters, the lock is first tested
+ *          without blocking, and the time spent waiting for it is counted
+ *          only if another thread holds it.
+ * @param fsr_id the ID of the FSR
+ */
+inline void CPUSolver::setFSRLock(int fsr_id) {
+
+#ifdef SWEEP_COUNTERS
+  int tid = omp_get_thread_num();
+
+  _sweep_counters(tid, FSR_LOCK_ACQUISITIONS)++;
+
+  if (!omp_test_lock(&_FSR_locks[fsr_id])) {
+    double start = omp_get_wtime();
+    omp_set_lock(&_FSR_locks[fsr_id]);
+    _sweep_counters(tid, FSR_LOCK_CONTENTIONS)++;
+    _sweep_counters(tid, FSR_LOCK_WAIT_TIME) += omp_get_wtime() - start;
+  }
+#else
+  omp_set_lock(&_FSR_locks[fsr_id]);
+#endif
+}
+
+
+/**
+ * @brief Sweeps a Track in the forward and reverse directions with the
+ *        per-segment routines of a CPUSolver subclass.
+ * @details The subclass routines are called through qualified names so that
+ *          they are bound at compile time and may be inlined into the sweep
+ *          loop rather than called through the virtual function table. The
+ *          subclass must provide the scalarFluxTally(...) and
+ *          transferBoundaryFlux(...) routines.
+ * @param track_id the ID of the Track to sweep
+ * @param fsr_flux a pointer to the temporary FSR flux buffer
+ */
+template <class SOLVER>
+void CPUSolver::sweepTrack(int track_id, FP_PRECISION* fsr_flux) {
+
+  SOLVER* solver = static_cast<SOLVER*>(this);
+
+  int azim_index = _tracks[track_id]->getAzimAngleIndex();
+  int min_segment = _segment_offsets[track_id];
+  int max_segment = _segment_offsets[track_id+1];
+  FP_PRECISION* track_flux = &_boundary_flux(track_id,0,0,0);
+
+  /* Loop over each Track segment in forward direction */
+  for (int s=min_segment; s < max_segment; s++)
+    solver->SOLVER::scalarFluxTally(s, azim_index, track_flux, fsr_flux, true);
+
+  /* Transfer boundary angular flux to outgoing Track */
+  solver->SOLVER::transferBoundaryFlux(track_id, azim_index, true, track_flux);
+
+  /* Loop over each Track segment in reverse direction */
+  track_flux += _polar_times_groups;
+
+  for (int s=max_segment-1; s >= min_segment; s--)
+    solver->SOLVER::scalarFluxTally(s, azim_index, track_flux, fsr_flux, false);
+
+  /* Transfer boundary angular flux to outgoing Track */
+  solver->SOLVER::transferBoundaryFlux(track_id, azim_index, false, track_flux);
+}
+
+
 #endif /* CPUSOLVER_H_ */
@@ -37,6 +37,7 @@ Cmfd::Cmfd() {
   /* Set matrices and arrays to NULL */
   _A = NULL;
   _M = NULL;
+  _materials = NULL;
   _flux_temp = NULL;
   _old_source = NULL;
   _new_source = NULL;
@@ -521,7 +522,9 @@ FP_PRECISION Cmfd::computeKeff(int moc_iteration){
       _volumes = new FP_PRECISION[_num_x*_num_y];
 
       initializeFlux();
-      initializeMaterials();
+
+      if (_materials == NULL)
+        initializeMaterials();
 
       for (int i = 0; i < _num_x*_num_y; i++){
         _M[i] = new FP_PRECISION[_num_cmfd_groups*_num_cmfd_groups];
@@ -1708,6 +1711,58 @@ void Cmfd::setPolarQuadrature(quadratureType quadrature_type, int num_polar) {
   _quad = new Quadrature(quadrature_type, num_polar);
 }
 
+/**
+ * @brief Returns the number of surface diffusion coefficient corrections.
+ * @details There are four corrections for each Mesh cell and CMFD energy
+ *          group, one for each surface of the cell.
+ * @return the number of diffusion coefficient corrections
+ */
+int Cmfd::getNumDifTildes(){
+  return 4 * _num_x * _num_y * _num_cmfd_groups;
+}
+
+
+/**
+ * @brief Copies the under-relaxed surface diffusion coefficient corrections
+ *        of each Mesh cell into an array.
+ * @details The corrections are zero before the first CMFD solve.
+ * @param dif_tildes an array of the corrections for each Mesh cell
+ */
+void Cmfd::getDifTildes(FP_PRECISION* dif_tildes){
+
+  int num_cell_tildes = 4 * _num_cmfd_groups;
+
+  for (int i = 0; i < _num_x*_num_y; i++){
+    for (int e = 0; e < num_cell_tildes; e++){
+      if (_materials == NULL)
+        dif_tildes[i*num_cell_tildes + e] = 0.0;
+      else
+        dif_tildes[i*num_cell_tildes + e] =
+            _materials[i]->getDifTilde()[e];
+    }
+  }
+}
+
+
+/**
+ * @brief Sets the under-relaxed surface diffusion coefficient corrections
+ *        of each Mesh cell, such as those of a restarted calculation.
+ * @param dif_tildes an array of the corrections for each Mesh cell
+ */
+void Cmfd::setDifTildes(FP_PRECISION* dif_tildes){
+
+  int num_cell_tildes = 4 * _num_cmfd_groups;
+
+  if (_materials == NULL)
+    initializeMaterials();
+
+  for (int i = 0; i < _num_x*_num_y; i++){
+    for (int e = 0; e < num_cell_tildes; e++)
+      _materials[i]->getDifTilde()[e] = dif_tildes[i*num_cell_tildes + e];
+  }
+}
+
+
 FP_PRECISION Cmfd::getFluxRatio(int cmfd_cell, int moc_group){
 
   int cmfd_group = _group_indices_map[moc_group];
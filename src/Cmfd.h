@@ -177,6 +177,8 @@ public:
   std::vector< std::vector<int> > getCellFSRs();
   bool isFluxUpdateOn();
   FP_PRECISION getFluxRatio(int cmfd_cell, int moc_group);
+  int getNumDifTildes();
+  void getDifTildes(FP_PRECISION* dif_tildes);
 
   /* Set parameters */
   void setSORRelaxationFactor(FP_PRECISION SOR_factor);
@@ -196,6 +198,7 @@ public:
   void setGroupStructure(int* group_indices, int length_group_indices);
   void setSourceConvergenceThreshold(FP_PRECISION source_thresh);
   void setPolarQuadrature(quadratureType quadrature_type, int num_polar);
+  void setDifTildes(FP_PRECISION* dif_tildes);
   
   /* Set FSR parameters */
   void setFSRMaterials(Material** FSR_materials);
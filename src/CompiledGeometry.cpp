@@ -0,0 +1,802 @@
+#include "CompiledGeometry.h"
+
+
+/**
+ * @brief Constructor initializes an empty CompiledGeometry.
+ */
+CompiledGeometry::CompiledGeometry() {
+  _compiled = false;
+  _cmfd_lattice = -1;
+  _max_depth = 0;
+}
+
+
+/**
+ * @brief Destructor.
+ */
+CompiledGeometry::~CompiledGeometry() { }
+
+
+/**
+ * @brief Lowers the Surfaces, Cells, Universes and Lattices into the flat
+ *        arrays used for ray tracing.
+ * @details This is called by the Geometry once its Cells have been
+ *          subdivided into rings and sectors and its CMFD mesh has been
+ *          created. Any earlier compilation is discarded.
+ * @param universes a std::map of all Universes (including Lattices) by ID
+ * @param cmfd_lattice the Lattice of the CMFD mesh or NULL without CMFD
+ */
+void CompiledGeometry::compile(std::map<int, Universe*>& universes,
+                               Lattice* cmfd_lattice) {
+
+  clear();
+
+  std::map<int, Universe*>::iterator univ_iter;
+  std::map<int, Cell*>::iterator cell_iter;
+  std::map<int, surface_halfspace>::iterator surf_iter;
+
+  /* Dense indices of the Cells and Surfaces by UID */
+  std::map<int, int> cell_indices;
+  std::map<int, int> surface_indices;
+
+  /* Give each Universe a dense index */
+  for (univ_iter = universes.begin(); univ_iter != universes.end();
+       ++univ_iter) {
+    _universe_indices[univ_iter->first] = _universe_ids.size();
+    _universe_ids.push_back(univ_iter->first);
+  }
+
+  _universe_cell_offsets.push_back(0);
+  _universe_surface_offsets.push_back(0);
+  _cell_surface_offsets.push_back(0);
+  _lattice_cell_offsets.push_back(0);
+
+  for (univ_iter = universes.begin(); univ_iter != universes.end();
+       ++univ_iter) {
+
+    Universe* univ = univ_iter->second;
+
+    /* Lattices are lowered into the Lattice arrays and have no Cells */
+    if (univ->getType() == LATTICE) {
+      _universe_lattices.push_back(addLattice(static_cast<Lattice*>(univ)));
+      _universe_cell_offsets.push_back(_universe_cells.size());
+      _universe_surface_offsets.push_back(_universe_surfaces.size());
+      continue;
+    }
+
+    _universe_lattices.push_back(-1);
+
+    /* The Cells are searched in the order of their IDs, as they are by
+     * Universe::findCell(...) */
+    std::map<int, Cell*> cells = univ->getCells();
+    std::vector<int> univ_surfaces;
+
+    for (cell_iter = cells.begin(); cell_iter != cells.end(); ++cell_iter) {
+
+      Cell* cell = cell_iter->second;
+
+      /* Lower each Cell the first time it is found */
+      if (cell_indices.find(cell->getUid()) == cell_indices.end()) {
+
+        cell_indices[cell->getUid()] = _cell_ids.size();
+        _cell_ids.push_back(cell->getId());
+
+        if (cell->getType() == MATERIAL) {
+          _cell_fills.push_back(-1);
+          _cell_basics.push_back(static_cast<CellBasic*>(cell));
+        }
+        else {
+          int fill_id = static_cast<CellFill*>(cell)->getUniverseFillId();
+
+          if (_universe_indices.find(fill_id) == _universe_indices.end())
+            log_printf(ERROR, "Unable to compile the Geometry since Cell "
+                       "ID = %d is filled by Universe ID = %d which is not "
+                       "in the Geometry", cell->getId(), fill_id);
+
+          _cell_fills.push_back(_universe_indices[fill_id]);
+          _cell_basics.push_back(NULL);
+        }
+
+        std::map<int, surface_halfspace> surfaces = cell->getSurfaces();
+
+        for (surf_iter = surfaces.begin(); surf_iter != surfaces.end();
+             ++surf_iter) {
+
+          Surface* surface = surf_iter->second._surface;
+
+          /* Lower each Surface the first time it is found */
+          if (surface_indices.find(surface->getUid()) ==
+              surface_indices.end()) {
+
+            surface_indices[surface->getUid()] = _surface_types.size();
+            _surface_types.push_back(surface->getSurfaceType());
+
+            if (surface->getSurfaceType() == CIRCLE) {
+              Circle* circle = static_cast<Circle*>(surface);
+              _surface_A.push_back(circle->_A);
+              _surface_B.push_back(circle->_B);
+              _surface_C.push_back(circle->_C);
+              _surface_D.push_back(circle->_D);
+              _surface_E.push_back(circle->_E);
+            }
+            else if (surface->getSurfaceType() == PLANE ||
+                     surface->getSurfaceType() == XPLANE ||
+                     surface->getSurfaceType() == YPLANE ||
+                     surface->getSurfaceType() == ZPLANE) {
+              Plane* plane = static_cast<Plane*>(surface);
+              _surface_A.push_back(plane->_A);
+              _surface_B.push_back(plane->_B);
+              _surface_C.push_back(plane->_C);
+              _surface_D.push_back(0.);
+              _surface_E.push_back(0.);
+            }
+            else
+              log_printf(ERROR, "Unable to compile the Geometry since "
+                         "Surface ID = %d has an unsupported type",
+                         surface->getId());
+          }
+
+          _cell_surfaces.push_back(surface_indices[surface->getUid()]);
+          _cell_halfspaces.push_back(surf_iter->second._halfspace);
+        }
+
+        _cell_surface_offsets.push_back(_cell_surfaces.size());
+      }
+
+      int index = cell_indices[cell->getUid()];
+      _universe_cells.push_back(index);
+
+      /* Collect the Surfaces of all of the Universe's Cells */
+      for (int s=_cell_surface_offsets[index];
+           s < _cell_surface_offsets[index+1]; s++)
+        univ_surfaces.push_back(_cell_surfaces[s]);
+    }
+
+    std::sort(univ_surfaces.begin(), univ_surfaces.end());
+    univ_surfaces.erase(std::unique(univ_surfaces.begin(),
+                                    univ_surfaces.end()),
+                        univ_surfaces.end());
+    _universe_surfaces.insert(_universe_surfaces.end(),
+                              univ_surfaces.begin(), univ_surfaces.end());
+
+    _universe_cell_offsets.push_back(_universe_cells.size());
+    _universe_surface_offsets.push_back(_universe_surfaces.size());
+  }
+
+  /* The CMFD mesh is a Lattice without Universes */
+  if (cmfd_lattice != NULL)
+    _cmfd_lattice = addLattice(cmfd_lattice);
+
+  /* Find the deepest nesting of Universes and Lattices in the root */
+  std::vector<int> depths(_universe_ids.size(), 0);
+
+  if (_universe_indices.find(0) != _universe_indices.end())
+    _max_depth = findUniverseDepth(_universe_indices[0], depths);
+
+  _compiled = true;
+
+  log_printf(INFO, "Compiled the Geometry into %d Universes, %d Lattices, "
+             "%d Cells and %d Surfaces", int(_universe_ids.size()),
+             int(_lattice_ids.size()), int(_cell_ids.size()),
+             int(_surface_types.size()));
+}
+
+
+/**
+ * @brief Lowers a Lattice into the Lattice arrays.
+ * @details The Universes of the Lattice cells must already have been given
+ *          their dense indices. A Lattice without Universes, such as the
+ *          CMFD mesh, is only used to find distances to its cell edges.
+ * @param lattice a pointer to the Lattice
+ * @return the index of the Lattice in the Lattice arrays
+ */
+int CompiledGeometry::addLattice(Lattice* lattice) {
+
+  int index = _lattice_ids.size();
+
+  _lattice_ids.push_back(lattice->getId());
+  _lattice_num_x.push_back(lattice->getNumX());
+  _lattice_num_y.push_back(lattice->getNumY());
+  _lattice_width_x.push_back(lattice->getWidthX());
+  _lattice_width_y.push_back(lattice->getWidthY());
+  _lattice_offset_x.push_back(lattice->getOffset()->getX());
+  _lattice_offset_y.push_back(lattice->getOffset()->getY());
+
+  if (lattice->getUniverses().size() != 0) {
+    for (int j=0; j < lattice->getNumY(); j++) {
+      for (int i=0; i < lattice->getNumX(); i++) {
+
+        Universe* univ = lattice->getUniverse(i, j);
+
+        if (univ == NULL ||
+            _universe_indices.find(univ->getId()) == _universe_indices.end())
+          log_printf(ERROR, "Unable to compile the Geometry since cell "
+                     "(%d, %d) of Lattice ID = %d is not filled by a "
+                     "Universe in the Geometry", i, j, lattice->getId());
+
+        _lattice_universes.push_back(_universe_indices[univ->getId()]);
+      }
+    }
+  }
+
+  _lattice_cell_offsets.push_back(_lattice_universes.size());
+
+  return index;
+}
+
+
+/**
+ * @brief Finds the number of LocalCoords levels from a Universe down to its
+ *        most deeply nested Cell.
+ * @details A Universe and a Lattice each add one level, and a Lattice cell
+ *          adds the levels of the Universe filling it. The depth of each
+ *          Universe is stored so that it is only found once.
+ * @param universe the index of the Universe
+ * @param depths the depth of each Universe index, 0 if it is not yet
+ *        known and -1 while it is being found
+ * @return the number of levels
+ */
+int CompiledGeometry::findUniverseDepth(int universe,
+                                        std::vector<int>& depths) {
+
+  if (depths[universe] > 0)
+    return depths[universe];
+
+  if (depths[universe] == -1)
+    log_printf(ERROR, "Unable to compile the Geometry since Universe ID = "
+               "%d is nested within itself", _universe_ids[universe]);
+
+  depths[universe] = -1;
+  int max_depth = 0;
+  int lattice = _universe_lattices[universe];
+
+  /* Descend into the Universe in each Lattice cell */
+  if (lattice != -1) {
+    for (int i=_lattice_cell_offsets[lattice];
+         i < _lattice_cell_offsets[lattice+1]; i++)
+      max_depth = std::max(max_depth,
+                           findUniverseDepth(_lattice_universes[i], depths));
+  }
+
+  /* Descend into the Universe filling each CellFill */
+  else {
+    for (int i=_universe_cell_offsets[universe];
+         i < _universe_cell_offsets[universe+1]; i++) {
+      int fill = _cell_fills[_universe_cells[i]];
+
+      if (fill != -1)
+        max_depth = std::max(max_depth, findUniverseDepth(fill, depths));
+    }
+  }
+
+  depths[universe] = max_depth + 1;
+  return depths[universe];
+}
+
+
+/**
+ * @brief Discards the compiled arrays.
+ */
+void CompiledGeometry::clear() {
+
+  _compiled = false;
+  _cmfd_lattice = -1;
+  _max_depth = 0;
+
+  _surface_types.clear();
+  _surface_A.clear();
+  _surface_B.clear();
+  _surface_C.clear();
+  _surface_D.clear();
+  _surface_E.clear();
+
+  _cell_ids.clear();
+  _cell_fills.clear();
+  _cell_basics.clear();
+  _cell_surface_offsets.clear();
+  _cell_surfaces.clear();
+  _cell_halfspaces.clear();
+
+  _universe_ids.clear();
+  _universe_lattices.clear();
+  _universe_cell_offsets.clear();
+  _universe_cells.clear();
+  _universe_surface_offsets.clear();
+  _universe_surfaces.clear();
+  _universe_indices.clear();
+
+  _lattice_ids.clear();
+  _lattice_num_x.clear();
+  _lattice_num_y.clear();
+  _lattice_width_x.clear();
+  _lattice_width_y.clear();
+  _lattice_offset_x.clear();
+  _lattice_offset_y.clear();
+  _lattice_cell_offsets.clear();
+  _lattice_universes.clear();
+}
+
+
+/**
+ * @brief Returns whether the Geometry has been compiled.
+ * @return true if the compiled arrays may be used; false otherwise
+ */
+bool CompiledGeometry::isCompiled() {
+  return _compiled;
+}
+
+
+/**
+ * @brief Returns the number of LocalCoords levels of the most deeply nested
+ *        Cell in the root Universe (ID = 0).
+ * @return the maximum number of levels, or 0 if there is no root Universe
+ */
+int CompiledGeometry::getMaxDepth() {
+  return _max_depth;
+}
+
+
+/**
+ * @brief Determines whether a Point is inside a Cell.
+ * @details This is the same test as Cell::cellContainsPoint(...).
+ * @param cell the index of the Cell
+ * @param x the x-coordinate of the Point in the Cell's Universe
+ * @param y the y-coordinate of the Point in the Cell's Universe
+ * @return true if the Point is in the Cell; false otherwise
+ */
+inline bool CompiledGeometry::cellContainsPoint(int cell, double x,
+                                                double y) {
+
+  for (int i=_cell_surface_offsets[cell];
+       i < _cell_surface_offsets[cell+1]; i++) {
+
+    int s = _cell_surfaces[i];
+    double value;
+
+    if (_surface_types[s] == CIRCLE)
+      value = _surface_A[s] * x * x + _surface_B[s] * y * y +
+              _surface_C[s] * x + _surface_D[s] * y + _surface_E[s];
+    else
+      value = _surface_A[s] * x + _surface_B[s] * y + _surface_C[s];
+
+    if (value * _cell_halfspaces[i] < -ON_SURFACE_THRESH)
+      return false;
+  }
+
+  return true;
+}
+
+
+/**
+ * @brief Finds the distance from a Point to a Surface along a trajectory.
+ * @details This computes the same intersections as Plane::intersection(...)
+ *          and Circle::intersection(...) followed by
+ *          Surface::getMinDistance(...).
+ * @param surface the index of the Surface
+ * @param x0 the x-coordinate of the Point
+ * @param y0 the y-coordinate of the Point
+ * @param angle the angle of the trajectory
+ * @param m the slope of the trajectory, sin(angle) / cos(angle)
+ * @return the distance to the Surface or INFINITY if it is not crossed
+ */
+inline double CompiledGeometry::surfaceMinDist(int surface, double x0,
+                                               double y0, double angle,
+                                               double m) {
+
+  double A = _surface_A[surface];
+  double B = _surface_B[surface];
+  double C = _surface_C[surface];
+  double xcurr[2], ycurr[2];
+  int num_roots;
+
+  bool vertical = fabs(angle - (M_PI / 2)) < 1.0e-10;
+
+  /* Find where the trajectory crosses a Plane */
+  if (_surface_types[surface] != CIRCLE) {
+
+    num_roots = 1;
+
+    if (vertical) {
+      if (B == 0)
+        return INFINITY;
+      xcurr[0] = x0;
+      ycurr[0] = (-A * x0 - C) / B;
+    }
+    else {
+      if (fabs(-A/B - m) < 1e-11 && B != 0)
+        return INFINITY;
+      xcurr[0] = -(B * (y0 - m * x0) + C) / (A + B * m);
+      ycurr[0] = y0 + m * (xcurr[0] - x0);
+    }
+  }
+
+  /* Find where the trajectory crosses a Circle */
+  else {
+
+    double D = _surface_D[surface];
+    double E = _surface_E[surface];
+    double a, b, c, q, discr;
+
+    if (vertical) {
+      a = B * B;
+      b = D;
+      c = A * x0 * x0 + C * x0 + E;
+    }
+    else {
+      q = y0 - m * x0;
+      a = A + B * B * m * m;
+      b = 2 * B * m * q + C + D * m;
+      c = B * q * q + D * q + E;
+    }
+
+    discr = b*b - 4*a*c;
+
+    if (discr < 0)
+      return INFINITY;
+
+    double roots[2];
+
+    /* There is one intersection (ie on the Surface) */
+    if (discr == 0) {
+      num_roots = 1;
+      roots[0] = -b / (2*a);
+    }
+
+    /* There are two intersections */
+    else {
+      num_roots = 2;
+      roots[0] = (-b + sqrt(discr)) / (2*a);
+      roots[1] = (-b - sqrt(discr)) / (2*a);
+    }
+
+    for (int r=0; r < num_roots; r++) {
+      if (vertical) {
+        xcurr[r] = x0;
+        ycurr[r] = roots[r];
+      }
+      else {
+        xcurr[r] = roots[r];
+        ycurr[r] = y0 + m * (xcurr[r] - x0);
+      }
+    }
+  }
+
+  /* Keep the nearest crossing in the direction of the trajectory */
+  double min_dist = INFINITY;
+
+  for (int r=0; r < num_roots; r++) {
+    if ((angle < M_PI && ycurr[r] > y0) || (angle > M_PI && ycurr[r] < y0)) {
+      double deltax = xcurr[r] - x0;
+      double deltay = ycurr[r] - y0;
+      double dist = sqrt(deltax*deltax + deltay*deltay);
+      if (dist < min_dist)
+        min_dist = dist;
+    }
+  }
+
+  return min_dist;
+}
+
+
+/**
+ * @brief Finds the distance from a Point to the nearest Surface bounding
+ *        any Cell in a Universe along a trajectory.
+ * @details This is the distance found by Universe::minSurfaceDist(...).
+ * @param universe the index of the Universe
+ * @param x the x-coordinate of the Point in the Universe
+ * @param y the y-coordinate of the Point in the Universe
+ * @param angle the angle of the trajectory
+ * @param m the slope of the trajectory, sin(angle) / cos(angle)
+ * @return the distance to the nearest Surface
+ */
+inline double CompiledGeometry::universeMinDist(int universe, double x,
+                                                double y, double angle,
+                                                double m) {
+
+  double min_dist = INFINITY;
+
+  for (int i=_universe_surface_offsets[universe];
+       i < _universe_surface_offsets[universe+1]; i++)
+    min_dist = std::min(surfaceMinDist(_universe_surfaces[i], x, y,
+                                       angle, m), min_dist);
+
+  return min_dist;
+}
+
+
+/**
+ * @brief Finds the Lattice cell x index that a point lies in.
+ * @details This is the index found by Lattice::getLatX(...).
+ * @param lattice the index of the Lattice
+ * @param x the x-coordinate of the point
+ * @return the Lattice cell x index
+ */
+inline int CompiledGeometry::getLatX(int lattice, double x) {
+
+  int num_x = _lattice_num_x[lattice];
+  double width_x = _lattice_width_x[lattice];
+  double offset_x = _lattice_offset_x[lattice];
+
+  int lat_x = (int)floor((x + width_x*num_x/2.0 - offset_x) / width_x);
+  double dist_to_left = x + num_x*width_x/2.0 - offset_x;
+
+  if (fabs(dist_to_left) < ON_SURFACE_THRESH)
+    lat_x = 0;
+  else if (fabs(dist_to_left - num_x*width_x) < ON_SURFACE_THRESH)
+    lat_x = num_x - 1;
+  else if (lat_x < 0 || lat_x > num_x-1)
+    log_printf(ERROR, "Trying to get lattice x index for point that is "
+               "outside lattice bounds.");
+
+  return lat_x;
+}
+
+
+/**
+ * @brief Finds the Lattice cell y index that a point lies in.
+ * @details This is the index found by Lattice::getLatY(...).
+ * @param lattice the index of the Lattice
+ * @param y the y-coordinate of the point
+ * @return the Lattice cell y index
+ */
+inline int CompiledGeometry::getLatY(int lattice, double y) {
+
+  int num_y = _lattice_num_y[lattice];
+  double width_y = _lattice_width_y[lattice];
+  double offset_y = _lattice_offset_y[lattice];
+
+  int lat_y = (int)floor((y + width_y*num_y/2.0 - offset_y) / width_y);
+  double dist_to_bottom = y + width_y*num_y/2.0 - offset_y;
+
+  if (fabs(dist_to_bottom) < ON_SURFACE_THRESH)
+    lat_y = 0;
+  else if (fabs(dist_to_bottom - num_y*width_y) < ON_SURFACE_THRESH)
+    lat_y = num_y - 1;
+  else if (lat_y < 0 || lat_y > num_y-1)
+    log_printf(ERROR, "Trying to get lattice y index for point that is "
+               "outside lattice bounds.");
+
+  return lat_y;
+}
+
+
+/**
+ * @brief Finds the distance from a point to the nearest Lattice cell edge
+ *        along a trajectory.
+ * @details This is the distance found by Lattice::minSurfaceDist(...).
+ * @param lattice the index of the Lattice
+ * @param lat_x the x index of the Lattice cell containing the point
+ * @param lat_y the y index of the Lattice cell containing the point
+ * @param x the x-coordinate of the point
+ * @param y the y-coordinate of the point
+ * @param angle the angle of the trajectory
+ * @param tan_angle the tangent of the angle
+ * @return the distance to the nearest Lattice cell edge
+ */
+inline double CompiledGeometry::latticeMinDist(int lattice, int lat_x,
+                                               int lat_y, double x, double y,
+                                               double angle,
+                                               double tan_angle) {
+
+  int num_x = _lattice_num_x[lattice];
+  int num_y = _lattice_num_y[lattice];
+  double width_x = _lattice_width_x[lattice];
+  double width_y = _lattice_width_y[lattice];
+  double next_x, next_y;
+  double dist_x, dist_y;
+  double dist_row, dist_col;
+
+  /* Find distance to next x plane crossing */
+  if (angle < M_PI / 2.0)
+    next_x = (lat_x + 1) * width_x - width_x*num_x/2.0 +
+             _lattice_offset_x[lattice];
+  else
+    next_x = lat_x * width_x - width_x*num_x/2.0 +
+             _lattice_offset_x[lattice];
+
+  next_y = y + tan_angle * (next_x - x);
+  dist_x = fabs(next_x - x);
+  dist_y = fabs(next_y - y);
+  dist_row = pow(pow(dist_x, 2) + pow(dist_y, 2), 0.5);
+
+  /* Find distance to next y plane crossing */
+  next_y = (lat_y + 1) * width_y - width_y*num_y/2.0 +
+           _lattice_offset_y[lattice];
+  next_x = x + (next_y - y) / tan_angle;
+  dist_x = fabs(next_x - x);
+  dist_y = fabs(next_y - y);
+  dist_col = pow(pow(dist_x, 2) + pow(dist_y, 2), 0.5);
+
+  return std::min(dist_row, dist_col);
+}
+
+
+/**
+ * @brief Finds the Cell containing a LocalCoords and fills in the
+ *        LocalCoords linked list below it.
+ * @details The LocalCoords already in the linked list are reused and any
+ *          below the level of the Cell are pruned. If a distance is
+ *          requested, the distance to the nearest Surface or Lattice cell
+ *          edge at each level is also found along the trajectory.
+ * @param coords a pointer to the LocalCoords with the ID of its Universe
+ * @param angle the angle of the trajectory
+ * @param min_dist a pointer to the minimum distance to update or NULL
+ * @return a pointer to the Cell or NULL if no Cell contains the LocalCoords
+ */
+CellBasic* CompiledGeometry::findCell(LocalCoords* coords, double angle,
+                                      double* min_dist) {
+
+  double m = 0.;
+  double tan_angle = 0.;
+
+  if (min_dist != NULL) {
+    m = sin(angle) / cos(angle);
+    tan_angle = tan(angle);
+  }
+
+  std::map<int, int>::iterator iter =
+    _universe_indices.find(coords->getUniverse());
+
+  if (iter == _universe_indices.end())
+    log_printf(ERROR, "Unable to find Universe ID = %d in the compiled "
+               "Geometry", coords->getUniverse());
+
+  int univ = iter->second;
+  LocalCoords* curr = coords;
+
+  /* Descend the Universes until a CellBasic is found */
+  while (true) {
+
+    double x = curr->getX();
+    double y = curr->getY();
+    double next_x, next_y;
+    int next_univ;
+    int lattice = _universe_lattices[univ];
+
+    /* Find the first Cell in the Universe which contains the point */
+    if (lattice == -1) {
+
+      curr->setType(UNIV);
+
+      if (min_dist != NULL)
+        *min_dist = std::min(universeMinDist(univ, x, y, angle, m),
+                             *min_dist);
+
+      int cell = -1;
+
+      for (int i=_universe_cell_offsets[univ];
+           i < _universe_cell_offsets[univ+1]; i++) {
+        if (cellContainsPoint(_universe_cells[i], x, y)) {
+          cell = _universe_cells[i];
+          break;
+        }
+      }
+
+      if (cell == -1) {
+        curr->prune();
+        return NULL;
+      }
+
+      curr->setCell(_cell_ids[cell]);
+
+      /* A CellBasic is the lowest level */
+      if (_cell_fills[cell] == -1) {
+        curr->prune();
+        return _cell_basics[cell];
+      }
+
+      next_univ = _cell_fills[cell];
+      next_x = x;
+      next_y = y;
+    }
+
+    /* Find the Lattice cell which contains the point */
+    else {
+
+      curr->setType(LAT);
+
+      int num_x = _lattice_num_x[lattice];
+      int num_y = _lattice_num_y[lattice];
+      double width_x = _lattice_width_x[lattice];
+      double width_y = _lattice_width_y[lattice];
+      double offset_x = _lattice_offset_x[lattice];
+      double offset_y = _lattice_offset_y[lattice];
+
+      int lat_x = getLatX(lattice, x);
+      int lat_y = getLatY(lattice, y);
+
+      if (lat_x < 0 || lat_x >= num_x || lat_y < 0 || lat_y >= num_y) {
+        curr->prune();
+        return NULL;
+      }
+
+      if (min_dist != NULL)
+        *min_dist = std::min(latticeMinDist(lattice, lat_x, lat_y, x, y,
+                                            angle, tan_angle), *min_dist);
+
+      /* Compute local position of the point in the next level Universe */
+      next_x = x - (-width_x*num_x/2.0 + offset_x + (lat_x + 0.5) * width_x)
+               + offset_x;
+      next_y = y - (-width_y*num_y/2.0 + offset_y + (lat_y + 0.5) * width_y)
+               + offset_y;
+
+      next_univ = _lattice_universes[_lattice_cell_offsets[lattice] +
+                                     lat_y * num_x + lat_x];
+
+      curr->setLattice(_lattice_ids[lattice]);
+      curr->setLatticeX(lat_x);
+      curr->setLatticeY(lat_y);
+    }
+
+    /* Move to the LocalCoords at the next level */
+    LocalCoords* next = curr->getNext();
+
+    if (next == NULL) {
+      next = new LocalCoords(next_x, next_y);
+      curr->setNext(next);
+      next->setPrev(curr);
+    }
+    else {
+      next->setX(next_x);
+      next->setY(next_y);
+    }
+
+    next->setUniverse(_universe_ids[next_univ]);
+    univ = next_univ;
+    curr = next;
+  }
+}
+
+
+/**
+ * @brief Finds the Cell containing a LocalCoords.
+ * @details This fills in the LocalCoords linked list below the LocalCoords
+ *          in the same way as Geometry::findCellContainingCoords(...).
+ * @param coords a pointer to the LocalCoords with the ID of its Universe
+ * @return a pointer to the Cell or NULL if no Cell contains the LocalCoords
+ */
+CellBasic* CompiledGeometry::findCellContainingCoords(LocalCoords* coords) {
+  return findCell(coords, 0., NULL);
+}
+
+
+/**
+ * @brief Moves a LocalCoords to the next Cell along a trajectory.
+ * @details The distance to the nearest Surface, Lattice cell edge or CMFD
+ *          mesh cell edge is found at every level of the LocalCoords linked
+ *          list while the Cell containing it is found. The LocalCoords at
+ *          the highest level is then moved just past that distance and the
+ *          Cell containing it is found.
+ * @param coords a pointer to the LocalCoords
+ * @param angle the angle of the trajectory
+ * @return a pointer to the next Cell or NULL if the trajectory leaves the
+ *         Geometry
+ */
+CellBasic* CompiledGeometry::findNextCell(LocalCoords* coords, double angle) {
+
+  double min_dist = std::numeric_limits<double>::infinity();
+
+  coords = coords->getHighestLevel();
+
+  /* Find the current Cell and the distance to the next one */
+  if (findCell(coords, angle, &min_dist) == NULL)
+    return NULL;
+
+  /* Check for distance to nearest CMFD mesh cell boundary */
+  if (_cmfd_lattice != -1) {
+    double x = coords->getX();
+    double y = coords->getY();
+    int lat_x = getLatX(_cmfd_lattice, x);
+    int lat_y = getLatY(_cmfd_lattice, y);
+    min_dist = std::min(latticeMinDist(_cmfd_lattice, lat_x, lat_y, x, y,
+                                       angle, tan(angle)), min_dist);
+  }
+
+  /* Move point and get next cell */
+  double delta_x = cos(angle) * (min_dist + TINY_MOVE);
+  double delta_y = sin(angle) * (min_dist + TINY_MOVE);
+  coords->setX(coords->getX() + delta_x);
+  coords->setY(coords->getY() + delta_y);
+
+  return findCell(coords, angle, NULL);
+}
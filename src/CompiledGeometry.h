@@ -0,0 +1,164 @@
+/**
+ * @file CompiledGeometry.h
+ * @brief The CompiledGeometry class.
+ * @date October 16, 2026
+ */
+
+#ifndef COMPILEDGEOMETRY_H_
+#define COMPILEDGEOMETRY_H_
+
+#ifdef __cplusplus
+#include <map>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "LocalCoords.h"
+#include "Universe.h"
+#include "Cell.h"
+#include "Surface.h"
+#endif
+
+
+/**
+ * @class CompiledGeometry CompiledGeometry.h "src/CompiledGeometry.h"
+ * @brief A flat, index-based copy of the Surfaces, Cells, Universes and
+ *        Lattices of a Geometry which is used for ray tracing.
+ * @details The Geometry lowers its constructive solid geometry into this
+ *          class once it is complete. Each Surface, Cell, Universe and
+ *          Lattice is given a dense index and its data is stored in
+ *          contiguous arrays, such as the coefficients of the Surfaces,
+ *          the Surfaces and halfspaces of the Cells and the Universes in
+ *          each Lattice cell. The Cells containing a LocalCoords and the
+ *          distances to the next Surfaces are then found without the
+ *          std::map lookups and virtual calls of the Universe, Cell and
+ *          Surface classes. The LocalCoords linked list is filled in the
+ *          same way as by Universe::findCell(...) and the distances are
+ *          computed with the same arithmetic as the Surface and Lattice
+ *          classes, so the Tracks are segmented identically.
+ */
+class CompiledGeometry {
+
+private:
+
+  /** Whether the Geometry has been compiled */
+  bool _compiled;
+
+  /** The type of each Surface (PLANE, XPLANE, CIRCLE, etc.) */
+  std::vector<int> _surface_types;
+
+  /** The x-squared (Circle) or x (Plane) coefficient of each Surface */
+  std::vector<double> _surface_A;
+
+  /** The y-squared (Circle) or y (Plane) coefficient of each Surface */
+  std::vector<double> _surface_B;
+
+  /** The x (Circle) or constant (Plane) coefficient of each Surface */
+  std::vector<double> _surface_C;
+
+  /** The y coefficient of each Circle */
+  std::vector<double> _surface_D;
+
+  /** The constant coefficient of each Circle */
+  std::vector<double> _surface_E;
+
+  /** The ID of each Cell */
+  std::vector<int> _cell_ids;
+
+  /** The index of the Universe filling each Cell or -1 for a CellBasic */
+  std::vector<int> _cell_fills;
+
+  /** A pointer to each Cell, which is NULL for a CellFill */
+  std::vector<CellBasic*> _cell_basics;
+
+  /** The offset of each Cell's Surfaces in the Cell Surface arrays */
+  std::vector<int> _cell_surface_offsets;
+
+  /** The index of each Surface bounding each Cell */
+  std::vector<int> _cell_surfaces;
+
+  /** The halfspace (+/-1) of each Surface bounding each Cell */
+  std::vector<double> _cell_halfspaces;
+
+  /** The ID of each Universe */
+  std::vector<int> _universe_ids;
+
+  /** The index of each Lattice in the Lattice arrays or -1 for a Universe */
+  std::vector<int> _universe_lattices;
+
+  /** The offset of each Universe's Cells in the Universe Cell array */
+  std::vector<int> _universe_cell_offsets;
+
+  /** The index of each Cell in each Universe in order of Cell ID */
+  std::vector<int> _universe_cells;
+
+  /** The offset of each Universe's Surfaces in the Universe Surface array */
+  std::vector<int> _universe_surface_offsets;
+
+  /** The index of each Surface bounding any Cell in each Universe */
+  std::vector<int> _universe_surfaces;
+
+  /** A std::map of Universe IDs (keys) to Universe indices (values) */
+  std::map<int, int> _universe_indices;
+
+  /** The ID of each Lattice */
+  std::vector<int> _lattice_ids;
+
+  /** The number of cells along the x-axis of each Lattice */
+  std::vector<int> _lattice_num_x;
+
+  /** The number of cells along the y-axis of each Lattice */
+  std::vector<int> _lattice_num_y;
+
+  /** The width of the cells along the x-axis of each Lattice */
+  std::vector<double> _lattice_width_x;
+
+  /** The width of the cells along the y-axis of each Lattice */
+  std::vector<double> _lattice_width_y;
+
+  /** The x-coordinate of the offset of each Lattice */
+  std::vector<double> _lattice_offset_x;
+
+  /** The y-coordinate of the offset of each Lattice */
+  std::vector<double> _lattice_offset_y;
+
+  /** The offset of each Lattice's cells in the Lattice Universe array */
+  std::vector<int> _lattice_cell_offsets;
+
+  /** The index of the Universe in each Lattice cell (y * num_x + x) */
+  std::vector<int> _lattice_universes;
+
+  /** The index of the CMFD mesh in the Lattice arrays or -1 without CMFD */
+  int _cmfd_lattice;
+
+  /** The number of LocalCoords levels of the most deeply nested Cell in
+   *  the root Universe (ID = 0) */
+  int _max_depth;
+
+  int addLattice(Lattice* lattice);
+  int findUniverseDepth(int universe, std::vector<int>& depths);
+  bool cellContainsPoint(int cell, double x, double y);
+  double surfaceMinDist(int surface, double x, double y, double angle,
+                        double m);
+  double universeMinDist(int universe, double x, double y, double angle,
+                         double m);
+  int getLatX(int lattice, double x);
+  int getLatY(int lattice, double y);
+  double latticeMinDist(int lattice, int lat_x, int lat_y, double x,
+                        double y, double angle, double tan_angle);
+  CellBasic* findCell(LocalCoords* coords, double angle, double* min_dist);
+
+public:
+
+  CompiledGeometry();
+  virtual ~CompiledGeometry();
+
+  void compile(std::map<int, Universe*>& universes, Lattice* cmfd_lattice);
+  void clear();
+  bool isCompiled();
+  int getMaxDepth();
+
+  CellBasic* findCellContainingCoords(LocalCoords* coords);
+  CellBasic* findNextCell(LocalCoords* coords, double angle);
+};
+
+#endif /* COMPILEDGEOMETRY_H_ */
@@ -24,6 +24,7 @@ Geometry::Geometry() {
 
   _num_FSRs = 0;
   _num_groups = 0;
+  _FSR_key_length = 0;
 
   /* Initialize CMFD object to NULL */
   _cmfd = NULL;
@@ -45,8 +46,8 @@ Geometry::~Geometry() {
 
   /* Free FSR  maps if they were initialized */
   if (_num_FSRs != 0) {
-    _FSR_keys_map.clear();
-    _FSRs_to_keys.clear();
+    _FSR_table.clear();
+    _FSRs_to_slots.clear();
     _FSRs_to_material_IDs.clear();
   }
 }
@@ -541,6 +542,9 @@ void Geometry::addSurface(Surface* surface) {
  */
 void Geometry::addCell(Cell* cell) {
 
+  /* Discard the compiled Geometry, which is now out of date */
+  _compiled_geometry.clear();
+
   /* Prints error msg if the Cell is filled with a non-existent Material */
   if (cell->getType() == MATERIAL &&
            _materials.find(static_cast<CellBasic*>(cell)->getMaterial()) ==
@@ -596,6 +600,9 @@ void Geometry::addCell(Cell* cell) {
  */
 void Geometry::addUniverse(Universe* universe) {
 
+  /* Discard the compiled Geometry, which is now out of date */
+  _compiled_geometry.clear();
+
   /* Add the Universe */
   try {
     _universes[universe->getId()] = universe;
@@ -702,6 +709,9 @@ void Geometry::removeMaterial(int id) {
  */
 void Geometry::removeCell(int id) {
 
+  /* Discard the compiled Geometry, which is now out of date */
+  _compiled_geometry.clear();
+
   /* Checks if the Geometry contains this Cell */
   if (_cells.find(id) == _cells.end())
     log_printf(WARNING, "Cannot remove a Cell with ID = %d from the "
@@ -729,6 +739,9 @@ void Geometry::removeCell(int id) {
  */
 void Geometry::removeUniverse(int id) {
 
+  /* Discard the compiled Geometry, which is now out of date */
+  _compiled_geometry.clear();
+
   /* Checks if the Geometry contains this Universe */
   if (_universes.find(id) == _universes.end())
     log_printf(WARNING, "Cannot remove a Universe with ID = %d from the "
@@ -760,6 +773,9 @@ void Geometry::removeUniverse(int id) {
  */
 void Geometry::removeLattice(int id) {
 
+  /* Discard the compiled Geometry, which is now out of date */
+  _compiled_geometry.clear();
+
   /* Checks if the Geometry contains this Universe */
   if (_lattices.find(id) == _lattices.end())
     log_printf(WARNING, "Cannot remove a Lattice with ID = %d from the "
@@ -801,6 +817,9 @@ void Geometry::removeLattice(int id) {
  */
 CellBasic* Geometry::findCellContainingCoords(LocalCoords* coords) {
 
+  if (_compiled_geometry.isCompiled())
+    return _compiled_geometry.findCellContainingCoords(coords);
+
   int universe_id = coords->getUniverse();
   Universe* univ = _universes.at(universe_id);
 
@@ -874,6 +893,9 @@ CellBasic* Geometry::findNextCell(LocalCoords* coords, double angle) {
   double min_dist = std::numeric_limits<double>::infinity();
   Point surf_intersection;
 
+  if (_compiled_geometry.isCompiled())
+    return _compiled_geometry.findNextCell(coords, angle);
+
   /* Find the current Cell */
   cell = findCellContainingCoords(coords);
 
@@ -936,54 +958,225 @@ CellBasic* Geometry::findNextCell(LocalCoords* coords, double angle) {
 /**
  * @brief Find and return the ID of the flat source region that a given
  *        LocalCoords object resides within.
+ * @details This method may be called by several threads at once. Each
+ *          thread first searches its private hash table of the FSRs it has
+ *          already found without a lock. The shared FSR hash table and
+ *          vectors are only searched and updated, one thread at a time,
+ *          for an FSR which the thread has not found before or whose
+ *          characteristic point may be replaced by one on this Track. The
+ *          thread then copies the FSR into its private table.
+ *          A new FSR is given the next free ID, so the IDs depend on the
+ *          order in which the threads find the FSRs until they are
+ *          renumbered with Geometry::renumberFSRs(...). The FSR's
+ *          characteristic point is the first one found on the Track with
+ *          the lowest UID, which does not depend on the order.
+ * @param coords a LocalCoords object pointer
+ * @param track_uid the UID of the Track being segmented, or -1 if the FSR
+ *        is not found during ray tracing
+ * @return the FSR ID for a given LocalCoords object
+ */
+int Geometry::findFSRId(LocalCoords* coords, int track_uid) {
+  std::vector<int> key;
+  return findFSRId(coords, track_uid, key);
+}
+
+
+/**
+ * @brief Find and return the ID of the flat source region that a given
+ *        LocalCoords object resides within, building its key in a buffer
+ *        which may be reused for each segment of a Track.
  * @param coords a LocalCoords object pointer
+ * @param track_uid the UID of the Track being segmented, or -1 if the FSR
+ *        is not found during ray tracing
+ * @param key a buffer for the FSR key
  * @return the FSR ID for a given LocalCoords object
  */
-int Geometry::findFSRId(LocalCoords* coords) {
+int Geometry::findFSRId(LocalCoords* coords, int track_uid,
+                        std::vector<int>& key) {
 
   int fsr_id = 0;
   LocalCoords* curr = coords;
   curr = coords->getLowestLevel();
-  std::hash<std::string> key_hash_function;
 
   /* Generate unique FSR key */
-  std::size_t fsr_key_hash = key_hash_function(getFSRKey(coords));
+  buildFSRKey(coords, key);
 
-  /* If FSR has not been encountered, update FSR maps and vectors */
-  if (_FSR_keys_map.find(fsr_key_hash) == _FSR_keys_map.end()){
-      
-    /* Get the cell that contains coords */
-    CellBasic* cell = findCellContainingCoords(curr);
-    
-    /* Add FSR information to FSR key map and FSR_to vectors */
-    fsr_id = _num_FSRs;
-    fsr_data* fsr = new fsr_data;
-    fsr->_fsr_id = fsr_id;
-    Point* point = new Point();
-    point->setCoords(coords->getHighestLevel()->getX(), 
-                     coords->getHighestLevel()->getY());
-    fsr->_point = point;
-    _FSR_keys_map[fsr_key_hash] = *fsr;
-    _FSRs_to_keys.push_back(fsr_key_hash);
-    _FSRs_to_material_IDs.push_back(cell->getMaterial());
-
-    /* If CMFD acceleration is on, add FSR to CMFD cell */
-    if (_cmfd != NULL){
-      int cmfd_cell = _cmfd->findCmfdCell(coords->getHighestLevel());
-      _cmfd->addFSRToCell(cmfd_cell, fsr_id);
+  /* Search this thread's private FSR table, which holds the lowest Track
+   * UID known for each FSR when the thread found it. The shared table only
+   * needs to be updated if this Track's UID is lower. */
+  int tid = omp_get_thread_num();
+  int thread_slot = -1;
+
+  if (tid < (int)_thread_FSR_tables.size()) {
+    thread_slot = findFSRSlot(_thread_FSR_tables[tid], _thread_FSR_keys[tid],
+                              &key[0]);
+    fsr_data& fsr = _thread_FSR_tables[tid][thread_slot];
+
+    if (fsr._fsr_id != -1 && track_uid >= fsr._track_uid)
+      return fsr._fsr_id;
+  }
+
+  int min_track_uid = track_uid;
+
+  #pragma omp critical (FSR_keys)
+  {
+    if (_FSR_table.empty())
+      growFSRTable();
+
+    int slot = findFSRSlot(_FSR_table, _FSR_keys, &key[0]);
+
+    /* If FSR has not been encountered, update FSR table and vectors */
+    if (_FSR_table[slot]._fsr_id == -1) {
+
+      /* Get the cell that contains coords */
+      CellBasic* cell = findCellContainingCoords(curr);
+
+      /* Add FSR information to FSR table and FSR_to vectors */
+      fsr_id = insertFSR(&key[0], slot, coords->getHighestLevel()->getX(),
+                         coords->getHighestLevel()->getY(),
+                         cell->getMaterial(), track_uid);
+
+      /* If CMFD acceleration is on, add FSR to CMFD cell */
+      if (_cmfd != NULL){
+        int cmfd_cell = _cmfd->findCmfdCell(coords->getHighestLevel());
+        _cmfd->addFSRToCell(cmfd_cell, fsr_id);
+      }
     }
+    /* If FSR has already been encountered, get the fsr id from the table */
+    else {
+      fsr_data& fsr = _FSR_table[slot];
+      fsr_id = fsr._fsr_id;
+
+      /* Keep the point found on the Track with the lowest UID */
+      if (track_uid < fsr._track_uid) {
+        fsr._point.setCoords(coords->getHighestLevel()->getX(),
+                             coords->getHighestLevel()->getY());
+        fsr._track_uid = track_uid;
+      }
 
-    /* Increment FSR counter */
-    _num_FSRs++;
+      min_track_uid = fsr._track_uid;
+    }
   }
-  /* If FSR has already been encountered, get the fsr id from map */
-  else
-    fsr_id = _FSR_keys_map.at(fsr_key_hash)._fsr_id;
-  
+
+  if (thread_slot != -1)
+    copyFSRToThread(&key[0], thread_slot, fsr_id, min_track_uid);
+
   return fsr_id;
 }
 
 
+/**
+ * @brief Renumbers the flat source regions.
+ * @details This is used by the TrackGenerator to number the FSRs in the
+ *          order in which the Tracks first cross them after the Tracks are
+ *          segmented in parallel, so that the FSR IDs do not depend on the
+ *          number of threads. The FSR table and vectors and the FSRs of each
+ *          CMFD cell are updated, and the FSRs of each CMFD cell are sorted
+ *          by ID as they would be if the FSRs had been found in that order.
+ * @param fsr_ids the new ID of each FSR indexed by its current ID
+ */
+void Geometry::renumberFSRs(std::vector<int>& fsr_ids) {
+
+  if ((int)fsr_ids.size() != _num_FSRs)
+    log_printf(ERROR, "Unable to renumber %d FSRs with %d new IDs",
+               _num_FSRs, (int)fsr_ids.size());
+
+  std::vector<int> FSRs_to_slots(_num_FSRs);
+  std::vector<int> FSRs_to_material_IDs(_num_FSRs);
+
+  for (int r=0; r < _num_FSRs; r++) {
+    FSRs_to_slots.at(fsr_ids[r]) = _FSRs_to_slots[r];
+    FSRs_to_material_IDs.at(fsr_ids[r]) = _FSRs_to_material_IDs[r];
+    _FSR_table[_FSRs_to_slots[r]]._fsr_id = fsr_ids[r];
+  }
+
+  _FSRs_to_slots.swap(FSRs_to_slots);
+  _FSRs_to_material_IDs.swap(FSRs_to_material_IDs);
+
+  /* Renumber the FSRs in each CMFD cell */
+  if (_cmfd != NULL) {
+
+    std::vector< std::vector<int> > cell_fsrs = _cmfd->getCellFSRs();
+
+    for (size_t i=0; i < cell_fsrs.size(); i++) {
+      for (size_t j=0; j < cell_fsrs[i].size(); j++)
+        cell_fsrs[i][j] = fsr_ids[cell_fsrs[i][j]];
+
+      std::sort(cell_fsrs[i].begin(), cell_fsrs[i].end());
+    }
+
+    _cmfd->setCellFSRs(cell_fsrs);
+  }
+}
+
+
+/**
+ * @brief Adds a new FSR with a given key, characteristic point and Material.
+ * @details This is used by the TrackGenerator to restore the FSRs when it
+ *          imports the Tracks from a file. The FSR is given the next free ID.
+ * @param key the FSR's key of Geometry::getFSRKeyLength() integers
+ * @param x the x-coordinate of the FSR's characteristic point
+ * @param y the y-coordinate of the FSR's characteristic point
+ * @param material_id the ID of the Material filling the FSR
+ * @return the ID of the new FSR
+ */
+int Geometry::addFSR(const int* key, double x, double y, int material_id) {
+
+  if (_FSR_table.empty())
+    growFSRTable();
+
+  int slot = findFSRSlot(_FSR_table, _FSR_keys, key);
+
+  if (_FSR_table[slot]._fsr_id != -1)
+    log_printf(ERROR, "Unable to add an FSR since its key is already used "
+               "by FSR %d", _FSR_table[slot]._fsr_id);
+
+  return insertFSR(key, slot, x, y, material_id, -1);
+}
+
+
+/**
+ * @brief Removes all of the FSRs from the Geometry.
+ */
+void Geometry::clearFSRs() {
+  _FSR_table.clear();
+  _FSR_keys.clear();
+  _FSRs_to_slots.clear();
+  _FSRs_to_material_IDs.clear();
+  _num_FSRs = 0;
+}
+
+
+/**
+ * @brief Creates an empty private FSR hash table for each thread which
+ *        will call Geometry::findFSRId(...).
+ * @details This is used by the TrackGenerator before the Tracks are
+ *          segmented in parallel. The private tables must be removed with
+ *          Geometry::clearThreadFSRTables() once the FSRs are renumbered.
+ * @param num_threads the number of threads
+ */
+void Geometry::initializeThreadFSRTables(int num_threads) {
+
+  _thread_FSR_tables.resize(num_threads);
+  _thread_FSR_keys.resize(num_threads);
+  _thread_num_FSRs.assign(num_threads, 0);
+
+  for (int t=0; t < num_threads; t++)
+    initializeFSRTable(_thread_FSR_tables[t], _thread_FSR_keys[t],
+                       FSR_TABLE_MIN_SLOTS);
+}
+
+
+/**
+ * @brief Removes the private FSR hash table of each thread.
+ */
+void Geometry::clearThreadFSRTables() {
+  std::vector< std::vector<fsr_data> >().swap(_thread_FSR_tables);
+  std::vector< std::vector<int> >().swap(_thread_FSR_keys);
+  _thread_num_FSRs.clear();
+}
+
+
 /**
  * @brief Return the ID of the flat source region that a given
  *        LocalCoords object resides within.
@@ -991,43 +1184,364 @@ int Geometry::findFSRId(LocalCoords* coords) {
  * @return the FSR ID for a given LocalCoords object
  */
 int Geometry::getFSRId(LocalCoords* coords) {
-    
-  int fsr_id = 0;
-  std::string fsr_key;
-  std::hash<std::string> key_hash_function;
-  
-  try{
-    fsr_key = getFSRKey(coords);
-    fsr_id = _FSR_keys_map.at(key_hash_function(fsr_key))._fsr_id;
-  }
-  catch(std::exception &e) {
+
+  std::vector<int> key;
+  buildFSRKey(coords, key);
+
+  int slot = findFSRSlot(_FSR_table, _FSR_keys, &key[0]);
+
+  if (slot == -1 || _FSR_table[slot]._fsr_id == -1)
     log_printf(ERROR, "Could not find FSR ID with key: %s. Try creating "
-               "geometry with finer track laydown. "
-               "Backtrace:%s", fsr_key.c_str(), e.what());
-  }
+               "geometry with finer track laydown.", getFSRKey(coords).c_str());
+
+  return _FSR_table[slot]._fsr_id;
+}
+
+
+/**
+ * @brief Returns the number of integers in each FSR key.
+ * @details This is set from the deepest nesting of Universes and Lattices
+ *          by Geometry::initializeFlatSourceRegions().
+ * @return the number of integers in each FSR key
+ */
+int Geometry::getFSRKeyLength() {
+  return _FSR_key_length;
+}
+
+
+/**
+ * @brief Return the key of a given FSR.
+ * @details The key is stored with the FSR hash table, so the pointer is
+ *          only valid until new FSRs are added to the Geometry.
+ * @param fsr_id the FSR ID
+ * @return a pointer to the Geometry::getFSRKeyLength() integers of the key
+ */
+int* Geometry::getFSRKeyPath(int fsr_id) {
 
-  return fsr_id;  
+  if (fsr_id < 0 || fsr_id >= _num_FSRs)
+    log_printf(ERROR, "Could not find the key of FSR: %d since there are %d "
+               "FSRs", fsr_id, _num_FSRs);
+
+  return &_FSR_keys[size_t(_FSRs_to_slots[fsr_id]) * _FSR_key_length];
 }
 
 
 /**
  * @brief Return the characteristic point for a given FSR ID
+ * @details The Point is stored in the FSR hash table, so the pointer is
+ *          only valid until new FSRs are added to the Geometry.
  * @param fsr_id the FSR ID
  * @return the FSR's characteristic point
  */
 Point* Geometry::getFSRPoint(int fsr_id) {
+  return &getFSRData(fsr_id)->_point;
+}
+
+
+/**
+ * @brief Return the ID and characteristic point of a given FSR.
+ * @details The fsr_data struct is a slot of the FSR hash table, so the
+ *          pointer is only valid until new FSRs are added to the Geometry.
+ * @param fsr_id the FSR ID
+ * @return a pointer to the FSR's fsr_data struct
+ */
+fsr_data* Geometry::getFSRData(int fsr_id) {
+
+  if (fsr_id < 0 || fsr_id >= _num_FSRs)
+    log_printf(ERROR, "Could not find characteristic point in FSR: %d "
+               "since there are %d FSRs", fsr_id, _num_FSRs);
+
+  return &_FSR_table[_FSRs_to_slots[fsr_id]];
+}
+
+
+/**
+ * @brief Packs the x and y indices of a Lattice cell into one integer.
+ * @param lat_x the Lattice cell x index
+ * @param lat_y the Lattice cell y index
+ * @return the packed Lattice cell indices
+ */
+static inline int packLatticeCell(int lat_x, int lat_y) {
+
+  if (lat_x < 0 || lat_x >= (1 << 16) || lat_y < 0 || lat_y >= (1 << 15))
+    log_printf(ERROR, "Unable to build an FSR key for Lattice cell (%d, %d) "
+               "since Lattices may have at most %d x %d cells",
+               lat_x, lat_y, 1 << 16, 1 << 15);
+
+  return (lat_y << 16) | lat_x;
+}
+
+
+/**
+ * @brief Builds the integer key of the FSR which a LocalCoords object
+ *        resides within.
+ * @details The first integer is the number of LocalCoords levels and the
+ *          second the CMFD mesh cell (or -1 without CMFD). Each level then
+ *          takes two integers, the Universe or Lattice ID followed by the
+ *          Lattice cell (y << 16 | x) or -1 for a Universe. The ID of the
+ *          Cell comes last and the rest of the key is padded with -1 up to
+ *          Geometry::getFSRKeyLength() integers, which fits the deepest
+ *          nesting in the Geometry. The key identifies the same FSR as the
+ *          string returned by Geometry::getFSRKey(...) but is cheaper to
+ *          build and compare.
+ * @param coords a LocalCoords object pointer
+ * @param key the vector to fill with the key
+ */
+void Geometry::buildFSRKey(LocalCoords* coords, std::vector<int>& key) {
 
-  Point* point;
-    
-  try{
-    point = _FSR_keys_map.at(_FSRs_to_keys.at(fsr_id))._point;
+  LocalCoords* curr = coords->getHighestLevel();
+  int max_levels = (_FSR_key_length - 3) / 2;
+  int num_levels = 0;
+  int index = 2;
+
+  if (_FSR_key_length == 0)
+    log_printf(ERROR, "Unable to build an FSR key since the Geometry has "
+               "not been initialized with initializeFlatSourceRegions()");
+
+  key.assign(_FSR_key_length, -1);
+
+  /* If CMFD is on, add the CMFD lattice cell to the key */
+  if (_cmfd != NULL)
+    key[1] = packLatticeCell(_cmfd->getLattice()->getLatX(curr->getPoint()),
+                             _cmfd->getLattice()->getLatY(curr->getPoint()));
+
+  /* Descend the linked list hierarchy until the lowest level has
+   * been reached */
+  while (true) {
+
+    if (num_levels == max_levels)
+      log_printf(ERROR, "Unable to build an FSR key for more than %d levels "
+                 "of nested Universes and Lattices since the Geometry has "
+                 "changed since initializeFlatSourceRegions() was called",
+                 max_levels);
+
+    /* Add the lattice ID and lattice cell to the key */
+    if (curr->getType() == LAT) {
+      key[index++] = curr->getLattice();
+      key[index++] = packLatticeCell(curr->getLatticeX(),
+                                     curr->getLatticeY());
+    }
+
+    /* Add the universe ID to the key */
+    else {
+      key[index++] = curr->getUniverse();
+      index++;
+    }
+
+    num_levels++;
+
+    /* If lowest coords reached break; otherwise get next coords */
+    if (curr->getNext() == NULL)
+      break;
+    else
+      curr = curr->getNext();
+  }
+
+  key[0] = num_levels;
+  key[index] = curr->getCell();
+}
+
+
+/**
+ * @brief Hashes an FSR key.
+ * @details This is the 64-bit FNV-1a hash of the integers in the key
+ *          followed by a final mix so that its low bits, which index the
+ *          FSR hash table, depend on all of the integers.
+ * @param key the FSR key
+ * @return the hash of the key
+ */
+std::size_t Geometry::hashFSRKey(const int* key) {
+
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (int i=0; i < _FSR_key_length; i++) {
+    hash ^= (uint32_t)key[i];
+    hash *= 1099511628211ULL;
   }
-  catch(std::exception &e) {
-    log_printf(ERROR, "Could not find characteristic poitn in FSR: %i. "
-               "Backtrace:%s", fsr_id, e.what());
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+
+  return (std::size_t)hash;
+}
+
+
+/**
+ * @brief Finds the slot of an FSR hash table which holds an FSR key.
+ * @details The table is probed linearly from the slot given by the key's
+ *          hash and the whole key is compared in each occupied slot, so
+ *          keys with the same hash are told apart.
+ * @param table the shared FSR hash table or a thread's private table
+ * @param keys the keys of the slots of the table
+ * @param key the FSR key
+ * @return the slot with the key, the empty slot where it would be inserted
+ *         or -1 if the table is empty
+ */
+int Geometry::findFSRSlot(const std::vector<fsr_data>& table,
+                          const std::vector<int>& keys, const int* key) {
+
+  if (table.empty())
+    return -1;
+
+  std::size_t mask = table.size() - 1;
+  std::size_t slot = hashFSRKey(key) & mask;
+  std::size_t key_size = _FSR_key_length * sizeof(int);
+
+  while (table[slot]._fsr_id != -1 &&
+         memcmp(&keys[slot * _FSR_key_length], key, key_size) != 0)
+    slot = (slot + 1) & mask;
+
+  return (int)slot;
+}
+
+
+/**
+ * @brief Inserts a new FSR into an empty slot of the FSR hash table.
+ * @details The table is grown once it is half full so that probes stay
+ *          short and there is always an empty slot.
+ * @param key the FSR key
+ * @param slot the empty slot returned by Geometry::findFSRSlot(...)
+ * @param x the x-coordinate of the FSR's characteristic point
+ * @param y the y-coordinate of the FSR's characteristic point
+ * @param material_id the ID of the Material filling the FSR
+ * @param track_uid the UID of the Track on which the point was found
+ * @return the ID of the new FSR
+ */
+int Geometry::insertFSR(const int* key, int slot, double x, double y,
+                        int material_id, int track_uid) {
+
+  int fsr_id = _num_FSRs;
+
+  fsr_data& fsr = _FSR_table[slot];
+  fsr._fsr_id = fsr_id;
+  fsr._track_uid = track_uid;
+  fsr._point.setCoords(x, y);
+  std::copy(key, key + _FSR_key_length,
+            &_FSR_keys[size_t(slot) * _FSR_key_length]);
+
+  _FSRs_to_slots.push_back(slot);
+  _FSRs_to_material_IDs.push_back(material_id);
+  _num_FSRs++;
+
+  if (2 * (std::size_t)_num_FSRs > _FSR_table.size())
+    growFSRTable();
+
+  return fsr_id;
+}
+
+
+/**
+ * @brief Fills an FSR hash table with a number of empty slots.
+ * @param table the FSR hash table
+ * @param keys the keys of the slots of the table
+ * @param num_slots the number of slots, which must be a power of two
+ */
+void Geometry::initializeFSRTable(std::vector<fsr_data>& table,
+                                  std::vector<int>& keys,
+                                  std::size_t num_slots) {
+
+  fsr_data empty;
+  empty._fsr_id = -1;
+  empty._track_uid = -1;
+  empty._point.setCoords(0., 0.);
+
+  table.assign(num_slots, empty);
+  keys.assign(num_slots * _FSR_key_length, -1);
+}
+
+
+/**
+ * @brief Reinserts the FSRs into an FSR hash table with a given number of
+ *        slots and key length.
+ * @details A longer key is padded with -1, as it would be if it were built
+ *          with that length, so the FSRs found before may still be found.
+ * @param num_slots the number of slots, which must be a power of two
+ * @param key_length the number of integers in each FSR key, which may not
+ *        be less than the current key length if there are FSRs
+ */
+void Geometry::rehashFSRTable(std::size_t num_slots, int key_length) {
+
+  int old_key_length = _FSR_key_length;
+  std::vector<fsr_data> old_table;
+  std::vector<int> old_keys;
+  std::vector<int> key(key_length, -1);
+
+  _FSR_key_length = key_length;
+  initializeFSRTable(old_table, old_keys, num_slots);
+  _FSR_table.swap(old_table);
+  _FSR_keys.swap(old_keys);
+
+  for (std::size_t i=0; i < old_table.size(); i++) {
+    if (old_table[i]._fsr_id != -1) {
+      std::copy(&old_keys[i * old_key_length],
+                &old_keys[i * old_key_length] + old_key_length, key.begin());
+      int slot = findFSRSlot(_FSR_table, _FSR_keys, &key[0]);
+      _FSR_table[slot] = old_table[i];
+      std::copy(key.begin(), key.end(),
+                &_FSR_keys[size_t(slot) * key_length]);
+      _FSRs_to_slots[old_table[i]._fsr_id] = slot;
+    }
   }
+}
 
-  return point;  
+
+/**
+ * @brief Doubles the number of slots in the FSR hash table and reinserts
+ *        the FSRs.
+ */
+void Geometry::growFSRTable() {
+  rehashFSRTable(std::max((std::size_t)FSR_TABLE_MIN_SLOTS,
+                          2 * _FSR_table.size()), _FSR_key_length);
+}
+
+
+/**
+ * @brief Copies an FSR into the calling thread's private FSR hash table.
+ * @details The private table is doubled in size once it is half full. Its
+ *          slots only hold the FSR key, ID and lowest known Track UID.
+ * @param key the FSR key
+ * @param slot the slot returned by Geometry::findFSRSlot(...) for the key
+ *        in the thread's private table
+ * @param fsr_id the FSR ID
+ * @param track_uid the lowest UID of a Track on which the FSR was found
+ */
+void Geometry::copyFSRToThread(const int* key, int slot, int fsr_id,
+                               int track_uid) {
+
+  int tid = omp_get_thread_num();
+  std::vector<fsr_data>& table = _thread_FSR_tables[tid];
+  std::vector<int>& keys = _thread_FSR_keys[tid];
+  fsr_data& fsr = table[slot];
+
+  fsr._track_uid = track_uid;
+
+  if (fsr._fsr_id != -1)
+    return;
+
+  fsr._fsr_id = fsr_id;
+  std::copy(key, key + _FSR_key_length,
+            &keys[size_t(slot) * _FSR_key_length]);
+  _thread_num_FSRs[tid]++;
+
+  if (2 * (std::size_t)_thread_num_FSRs[tid] <= table.size())
+    return;
+
+  std::vector<fsr_data> old_table;
+  std::vector<int> old_keys;
+  initializeFSRTable(old_table, old_keys, 2 * table.size());
+  table.swap(old_table);
+  keys.swap(old_keys);
+
+  for (std::size_t i=0; i < old_table.size(); i++) {
+    if (old_table[i]._fsr_id != -1) {
+      const int* old_key = &old_keys[i * _FSR_key_length];
+      int new_slot = findFSRSlot(table, keys, old_key);
+      table[new_slot] = old_table[i];
+      std::copy(old_key, old_key + _FSR_key_length,
+                &keys[size_t(new_slot) * _FSR_key_length]);
+    }
+  }
 }
 
 
@@ -1038,7 +1552,9 @@ Point* Geometry::getFSRPoint(int fsr_id) {
  *         level and Cells might overlap other cells, it is important to
  *         have a method for uniquely identifying FSRs. This method
  *         createds a unique FSR key by constructing a structured string
- *         that describes the hierarchy of lattices/universes/cells.
+ *         that describes the hierarchy of lattices/universes/cells. It is
+ *         meant for debugging, since the FSRs are found by the integer key
+ *         built by Geometry::buildFSRKey(...).
  * @param coords a LocalCoords object pointer
  * @return the FSR key
  */
@@ -1113,6 +1629,9 @@ std::string Geometry::getFSRKey(LocalCoords* coords) {
  */
 void Geometry::subdivideCells() {
 
+  /* Discard the compiled Geometry, which is now out of date */
+  _compiled_geometry.clear();
+
   std::map<int, Universe*>::iterator iter;
   Universe* curr;
 
@@ -1143,6 +1662,8 @@ void Geometry::subdivideCells() {
  */
 void Geometry::initializeFlatSourceRegions() {
 
+  TimerScope scope("Geometry initialization");
+
   /* Initialize pointers from CellFills to Universes */
   initializeCellFillPointers();
 
@@ -1160,6 +1681,41 @@ void Geometry::initializeFlatSourceRegions() {
   /* Initialize CMFD */
   if (_cmfd != NULL)
     initializeCmfd();
+
+  /* Lower the Geometry into flat arrays for ray tracing */
+  compileGeometry();
+}
+
+
+/**
+ * @brief Lowers the Surfaces, Cells, Universes and Lattices into the flat
+ *        arrays used for ray tracing.
+ * @details This is called by Geometry::initializeFlatSourceRegions(). Until
+ *          then, and after any Cell, Universe or Lattice is added to or
+ *          removed from the Geometry, the Cells are found by searching the
+ *          Universe, Cell and Surface objects.
+ */
+void Geometry::compileGeometry() {
+
+  Lattice* cmfd_lattice = NULL;
+
+  if (_cmfd != NULL)
+    cmfd_lattice = _cmfd->getLattice();
+
+  _compiled_geometry.compile(_universes, cmfd_lattice);
+
+  /* Size the FSR keys for the deepest nesting of Universes and Lattices.
+   * The keys of FSRs which were already found are kept, so the keys may
+   * be lengthened but not shortened. */
+  int key_length = 3 + 2 * _compiled_geometry.getMaxDepth();
+
+  if (_num_FSRs == 0) {
+    _FSR_key_length = key_length;
+    _FSR_table.clear();
+    _FSR_keys.clear();
+  }
+  else if (key_length > _FSR_key_length)
+    rehashFSRTable(_FSR_table.size(), key_length);
 }
 
 
@@ -1169,6 +1725,8 @@ void Geometry::initializeFlatSourceRegions() {
  * @details This method starts at the beginning of a Track and finds successive
  *          intersection points with FSRs as the Track crosses through the
  *          Geometry and creates segment structs and adds them to the Track.
+ *          Several Tracks may be segmented at the same time by different
+ *          threads.
  * @param track a pointer to a track to segmentize
  */
 void Geometry::segmentize(Track* track) {
@@ -1186,12 +1744,19 @@ void Geometry::segmentize(Track* track) {
   int min_num_segments;
   int num_segments;
 
+  /* The maximum and minimum segment lengths along this Track */
+  double max_seg_length = 0;
+  double min_seg_length = std::numeric_limits<double>::infinity();
+
   /* Use a LocalCoords for the start and end of each segment */
   LocalCoords segment_start(x0, y0);
   LocalCoords segment_end(x0, y0);
   segment_start.setUniverse(0);
   segment_end.setUniverse(0);
 
+  /* Buffer for the key of each segment's FSR */
+  std::vector<int> key;
+
   /* Find the Cell containing the Track starting Point */
   Cell* curr = findFirstCell(&segment_end, phi);
   Cell* prev;
@@ -1230,7 +1795,7 @@ void Geometry::segmentize(Track* track) {
     sigma_t = segment_material->getSigmaT();
 
     /* Find the ID of the FSR that contains the segment */
-    fsr_id = findFSRId(&segment_start);
+    fsr_id = findFSRId(&segment_start, track->getUid(), key);
 
     /* Compute the number of Track segments to cut this segment into to ensure
      * that it's length is small enough for the exponential table */
@@ -1251,10 +1816,10 @@ void Geometry::segmentize(Track* track) {
       new_segment->_length = segment_length / FP_PRECISION(min_num_segments);
 
       /* Update the max and min segment lengths */
-      if (segment_length > _max_seg_length)
-        _max_seg_length = segment_length;
-      if (segment_length < _min_seg_length)
-        _min_seg_length = segment_length;
+      if (segment_length > max_seg_length)
+        max_seg_length = segment_length;
+      if (segment_length < min_seg_length)
+        min_seg_length = segment_length;
 
       log_printf(DEBUG, "segment start x = %f, y = %f, segment end "
                  "x = %f, y = %f", segment_start.getX(), segment_start.getY(),
@@ -1307,9 +1872,17 @@ void Geometry::segmentize(Track* track) {
   segment_end.prune();
 
   log_printf(DEBUG, "Track %d max. segment length: %f",
-             track->getUid(), _max_seg_length);
+             track->getUid(), max_seg_length);
   log_printf(DEBUG, "Track %d min. segment length: %f",
-             track->getUid(), _min_seg_length);
+             track->getUid(), min_seg_length);
+
+  /* Update the max and min segment lengths in the Geometry, since other
+   * Tracks may be segmented at the same time */
+  #pragma omp critical (segment_lengths)
+  {
+    _max_seg_length = std::max(_max_seg_length, max_seg_length);
+    _min_seg_length = std::min(_min_seg_length, min_seg_length);
+  }
 
   return;
 }
@@ -1480,24 +2053,6 @@ void Geometry::initializeCmfd(){
 }
 
 
-/**
- * @brief Returns the map that maps FSR keys to FSR IDs
- * @return _FSR_keys_map map of FSR keys to FSR IDs
- */
-std::map<std::size_t, fsr_data> Geometry::getFSRKeysMap(){
-  return _FSR_keys_map;
-}
-
-
-/**
- * @brief Returns the vector that maps FSR IDs to FSR key hashes
- * @return _FSR_keys_map map of FSR keys to FSR IDs
- */
-std::vector<std::size_t> Geometry::getFSRsToKeys(){
-  return _FSRs_to_keys;
-}
-
-
 /**
  * @brief Return a vector indexed by flat source region IDs which contain
  *        the corresponding Material IDs.
@@ -1510,30 +2065,3 @@ std::vector<int> Geometry::getFSRsToMaterialIDs() {
 
   return _FSRs_to_material_IDs;
 }
-
-
-/**
- * @brief Sets the _FSR_keys_map map
- * @param FSR_keys_map map of FSR keys to FSR IDs
- */
-void Geometry::setFSRKeysMap(std::map<std::size_t, fsr_data> FSR_keys_map){
-  _FSR_keys_map = FSR_keys_map;
-}
-
-
-/**
- * @brief Sets the _FSRs_to_keys vector
- * @param FSRs_to_keys vector of FSR key hashes indexed by FSR IDs
- */
-void Geometry::setFSRsToKeys(std::vector<std::size_t> FSRs_to_keys){
-  _FSRs_to_keys = FSRs_to_keys;
-}
-
-
-/**
- * @brief Sets the _FSRs_to_material_IDs vector
- * @param FSRs_to_material_IDs vector mapping FSR IDs to cells
- */
-void Geometry::setFSRsToMaterialIDs(std::vector<int> FSRs_to_material_IDs){
-  _FSRs_to_material_IDs = FSRs_to_material_IDs;
-}
@@ -17,26 +17,40 @@
 #include "Track.h"
 #include "Surface.h"
 #include "Cmfd.h"
+#include "CompiledGeometry.h"
 #include <sstream>
+#include <cstring>
+#include <stdint.h>
 #include <string>
+#include <algorithm>
 #include <omp.h>
 #include <functional>
 #endif
 
+/** The initial number of slots in the FSR hash table (a power of two) */
+#define FSR_TABLE_MIN_SLOTS 1024
+
+
 /**
  * @struct fsr_data
  * @brief A fsr_data struct represents an FSR with a unique FSR ID
  *        and a characteristic point that lies within the FSR that
  *        can be used to recompute the hierarchical LocalCoords
  *        linked list.
+ * @details The fsr_data structs are the slots of the open addressing hash
+ *          table of FSR keys, the keys of which are stored in a separate
+ *          array. An empty slot has an FSR ID of -1.
  */
 struct fsr_data {
 
   /** The FSR ID */
   int _fsr_id;
 
+  /** The UID of the Track on which the characteristic point was found */
+  int _track_uid;
+
   /** Characteristic point in Universe 0 that lies in FSR */
-  Point* _point;
+  Point _point;
 
 };
 
@@ -87,15 +101,34 @@ private:
   /** The number of energy groups for each Material's nuclear data */
   int _num_groups;
 
-  /** An map of FSR key hashes to unique fsr_data structs */
-  std::map<std::size_t, fsr_data> _FSR_keys_map;
+  /** An open addressing hash table of fsr_data structs with linear
+   *  probing, the size of which is a power of two */
+  std::vector<fsr_data> _FSR_table;
+
+  /** The number of integers in each FSR key, which is set from the deepest
+   *  nesting of Universes and Lattices when the Geometry is compiled */
+  int _FSR_key_length;
+
+  /** The key of the FSR in each slot of the FSR hash table, with
+   *  _FSR_key_length integers for each slot */
+  std::vector<int> _FSR_keys;
 
-  /** An vector of FSR key hashes indexed by FSR ID */
-  std::vector<std::size_t> _FSRs_to_keys;
+  /** A vector of the slots of the FSRs in the hash table indexed by FSR ID */
+  std::vector<int> _FSRs_to_slots;
 
   /** A vector of Material IDs indexed by FSR IDs */
   std::vector<int> _FSRs_to_material_IDs;
 
+  /** A private hash table for each thread of the FSRs it has found during
+   *  ray tracing, which the thread searches without a lock */
+  std::vector< std::vector<fsr_data> > _thread_FSR_tables;
+
+  /** The keys of the slots of each thread's private hash table */
+  std::vector< std::vector<int> > _thread_FSR_keys;
+
+  /** The number of FSRs in each thread's private hash table */
+  std::vector<int> _thread_num_FSRs;
+
   /** The maximum Track segment length in the Geometry */
   double _max_seg_length;
 
@@ -120,9 +153,26 @@ private:
   /** A CMFD object pointer */
   Cmfd* _cmfd;
 
+  /** The flat arrays of Surfaces, Cells, Universes and Lattices used for
+   *  ray tracing */
+  CompiledGeometry _compiled_geometry;
+
   void initializeCellFillPointers();  
   CellBasic* findFirstCell(LocalCoords* coords, double angle);
   CellBasic* findNextCell(LocalCoords* coords, double angle);
+  void buildFSRKey(LocalCoords* coords, std::vector<int>& key);
+  std::size_t hashFSRKey(const int* key);
+  int findFSRSlot(const std::vector<fsr_data>& table,
+                  const std::vector<int>& keys, const int* key);
+  int findFSRId(LocalCoords* coords, int track_uid, std::vector<int>& key);
+  int insertFSR(const int* key, int slot, double x, double y,
+                int material_id, int track_uid);
+  void initializeFSRTable(std::vector<fsr_data>& table,
+                          std::vector<int>& keys, std::size_t num_slots);
+  void rehashFSRTable(std::size_t num_slots, int key_length);
+  void growFSRTable();
+  void copyFSRToThread(const int* key, int slot, int fsr_id,
+                       int track_uid);
 
 
 public:
@@ -156,17 +206,15 @@ public:
   Universe* getUniverse(int id);
   Lattice* getLattice(int id);
   Cmfd* getCmfd();
-  std::map<std::size_t, fsr_data> getFSRKeysMap();
-  std::vector<std::size_t> getFSRsToKeys();
+  fsr_data* getFSRData(int fsr_id);
   std::vector<int> getFSRsToMaterialIDs();
   int getFSRId(LocalCoords* coords);
+  int getFSRKeyLength();
+  int* getFSRKeyPath(int fsr_id);
   Point* getFSRPoint(int fsr_id);
   std::string getFSRKey(LocalCoords* coords);
 
   /* Set parameters */
-  void setFSRKeysMap(std::map<std::size_t, fsr_data> FSR_keys_map);
-  void setFSRsToMaterialIDs(std::vector<int> FSRs_to_material_IDs);
-  void setFSRsToKeys(std::vector<std::size_t> FSRs_to_keys);
   void setNumFSRs(int num_fsrs);
   void setCmfd(Cmfd* cmfd);
   
@@ -186,11 +234,17 @@ public:
   /* Find methods */
   CellBasic* findCellContainingCoords(LocalCoords* coords);
   Material* findFSRMaterial(int fsr_id);
-  int findFSRId(LocalCoords* coords);
+  int findFSRId(LocalCoords* coords, int track_uid=-1);
+  void renumberFSRs(std::vector<int>& fsr_ids);
+  int addFSR(const int* key, double x, double y, int material_id);
+  void clearFSRs();
+  void initializeThreadFSRTables(int num_threads);
+  void clearThreadFSRTables();
 
   /* Other worker methods */
   void subdivideCells();
   void initializeFlatSourceRegions();
+  void compileGeometry();
   void segmentize(Track* track);
   void computeFissionability(Universe* univ=NULL);
   std::string toString();
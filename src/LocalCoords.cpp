@@ -325,9 +325,10 @@ void LocalCoords::prune() {
 
 /**
  * @brief Copies a LocalCoords' values to this one.
- * details Given a pointer to a LocalCoords, it first prunes it and then creates
- *         a copy of the linked list of LocalCoords in the linked list below
- *         this one to give to the input LocalCoords.
+ * details Given a pointer to a LocalCoords, it creates a copy of the linked
+ *         list of LocalCoords in the linked list below this one to give to
+ *         the input LocalCoords. The LocalCoords already in the input's
+ *         linked list are reused and any left over are pruned.
  * @param coords a pointer to the LocalCoords to give the linked list copy to
  */
 void LocalCoords::copyCoords(LocalCoords* coords) {
@@ -335,9 +336,6 @@ void LocalCoords::copyCoords(LocalCoords* coords) {
   LocalCoords* curr1 = this;
   LocalCoords* curr2 = coords;
 
-  /* Prune the LocalCoords linked list */
-  curr2->prune();
-
   /* Iterate over this LocalCoords linked list and create a
    * copy of it for the input LocalCoords */
   while (curr1 != NULL) {
@@ -31,6 +31,9 @@ Material::Material(int id) {
   _sigma_t = NULL;
   _sigma_a = NULL;
   _sigma_s = NULL;
+  _sigma_s_begin = NULL;
+  _sigma_s_end = NULL;
+  _num_sigma_s_nonzeros = 0;
   _sigma_f = NULL;
   _nu_sigma_f = NULL;
   _chi = NULL;
@@ -120,6 +123,12 @@ Material::~Material() {
     if (_buckling != NULL)
       delete [] _buckling;
   }
+
+  if (_sigma_s_begin != NULL)
+    delete [] _sigma_s_begin;
+
+  if (_sigma_s_end != NULL)
+    delete [] _sigma_s_end;
 }
 
 
@@ -199,6 +208,46 @@ FP_PRECISION* Material::getSigmaS() {
 }
 
 
+/**
+ * @brief Return the array of the first origin group with a non-zero
+ *        scattering cross-section into each destination group.
+ * @details Together with Material::getSigmaSEnd(), this describes the band
+ *          of each row of the scattering matrix outside of which all
+ *          cross-sections are zero. Empty rows have equal begin and end.
+ * @return the pointer to the array of band start indices
+ */
+int* Material::getSigmaSBegin() {
+  if (_sigma_s_begin == NULL)
+    log_printf(ERROR, "Unable to return Material %d's scattering "
+               "band since its energy groups have not yet been set", _id);
+
+  return _sigma_s_begin;
+}
+
+
+/**
+ * @brief Return the array of one past the last origin group with a non-zero
+ *        scattering cross-section into each destination group.
+ * @return the pointer to the array of band end indices
+ */
+int* Material::getSigmaSEnd() {
+  if (_sigma_s_end == NULL)
+    log_printf(ERROR, "Unable to return Material %d's scattering "
+               "band since its energy groups have not yet been set", _id);
+
+  return _sigma_s_end;
+}
+
+
+/**
+ * @brief Return the number of non-zero entries in the scattering matrix.
+ * @return the number of non-zero scattering cross-sections
+ */
+int Material::getNumSigmaSNonZeros() {
+  return _num_sigma_s_nonzeros;
+}
+
+
 /**
  * @brief Return the array of the Material's fission cross-sections.
  * @return the pointer to the Material's array of fission cross-sections
@@ -599,6 +648,12 @@ void Material::setNumEnergyGroups(const int num_groups) {
       delete [] _buckling;
   }
 
+  if (_sigma_s_begin != NULL)
+    delete [] _sigma_s_begin;
+
+  if (_sigma_s_end != NULL)
+    delete [] _sigma_s_end;
+
   /* Allocate memory for data arrays */
   _sigma_t = new FP_PRECISION[_num_groups];
   _sigma_a = new FP_PRECISION[_num_groups];
@@ -606,6 +661,8 @@ void Material::setNumEnergyGroups(const int num_groups) {
   _nu_sigma_f = new FP_PRECISION[_num_groups];
   _chi = new FP_PRECISION[_num_groups];
   _sigma_s = new FP_PRECISION[_num_groups*_num_groups];
+  _sigma_s_begin = new int[_num_groups];
+  _sigma_s_end = new int[_num_groups];
 
 
   /* Assign the null vector to each data array */
@@ -615,6 +672,11 @@ void Material::setNumEnergyGroups(const int num_groups) {
   memset(_nu_sigma_f, 0.0, sizeof(FP_PRECISION) * _num_groups);
   memset(_chi, 0.0, sizeof(FP_PRECISION) * _num_groups);
   memset(_sigma_s, 0.0, sizeof(FP_PRECISION) * _num_groups * _num_groups);
+
+  /* The scattering matrix is empty until it is set */
+  memset(_sigma_s_begin, 0, sizeof(int) * _num_groups);
+  memset(_sigma_s_end, 0, sizeof(int) * _num_groups);
+  _num_sigma_s_nonzeros = 0;
 }
 
 
@@ -769,6 +831,8 @@ void Material::setSigmaS(double* xs, int num_groups_squared) {
     for (int orig=0; orig < _num_groups; orig++)
       _sigma_s[dest*_num_groups+orig] = xs[orig*_num_groups+dest];
   }
+
+  computeScatteringBands();
 }
 
 
@@ -785,7 +849,31 @@ void Material::setSigmaSByGroup(double xs, int origin, int destination) {
                "which contains %d energy groups",
                origin, destination, _uid, _num_groups);
 
-  _sigma_s[_num_groups*(destination-1) + (origin-1)] = xs;
+  FP_PRECISION* sigma_s = &_sigma_s[_num_groups*(destination-1) + (origin-1)];
+
+  /* Update the count of non-zero entries in the scattering matrix */
+  if (*sigma_s == 0. && xs != 0.)
+    _num_sigma_s_nonzeros++;
+  else if (*sigma_s != 0. && xs == 0.)
+    _num_sigma_s_nonzeros--;
+
+  *sigma_s = xs;
+
+  /* Widen the destination group's band to include a non-zero origin group.
+   * A band is never narrowed here since zeros inside it are harmless. */
+  if (xs != 0.) {
+    int dest = destination - 1;
+    int orig = origin - 1;
+
+    if (_sigma_s_begin[dest] == _sigma_s_end[dest]) {
+      _sigma_s_begin[dest] = orig;
+      _sigma_s_end[dest] = orig + 1;
+    }
+    else {
+      _sigma_s_begin[dest] = std::min(_sigma_s_begin[dest], orig);
+      _sigma_s_end[dest] = std::max(_sigma_s_end[dest], orig + 1);
+    }
+  }
 }
 
 
@@ -1256,6 +1344,53 @@ void Material::checkSigmaT() {
 }
 
 
+/**
+ * @brief Finds the band of non-zero origin groups for each destination
+ *        group in the scattering matrix.
+ * @details Most multi-group scattering matrices are sparse: there is no
+ *          upscattering from the fast groups and each group only scatters
+ *          into a narrow range of groups. The band for destination group G
+ *          is the range of origin groups [begin, end) outside of which all
+ *          scattering cross-sections into G are zero. The source update
+ *          in the Solvers only loops over each band rather than the full
+ *          scattering matrix. This method is called automatically when the
+ *          scattering matrix is set with Material::setSigmaS().
+ */
+void Material::computeScatteringBands() {
+
+  if (_sigma_s == NULL)
+    log_printf(ERROR, "Unable to compute Material %d's scattering bands "
+               "since its scattering cross-section has not been set", _id);
+
+  _num_sigma_s_nonzeros = 0;
+
+  for (int dest=0; dest < _num_groups; dest++) {
+
+    int begin = _num_groups;
+    int end = 0;
+
+    for (int orig=0; orig < _num_groups; orig++) {
+      if (_sigma_s[dest*_num_groups+orig] != 0.) {
+        begin = std::min(begin, orig);
+        end = orig + 1;
+        _num_sigma_s_nonzeros++;
+      }
+    }
+
+    /* Empty rows have an empty band */
+    if (begin >= end)
+      begin = end = 0;
+
+    _sigma_s_begin[dest] = begin;
+    _sigma_s_end[dest] = end;
+  }
+
+  log_printf(DEBUG, "Material %d has %d of %d non-zero scattering "
+             "cross-sections", _id, _num_sigma_s_nonzeros,
+             _num_groups * _num_groups);
+}
+
+
 /**
  * @brief Converts this Material's attributes to a character array
  *        representation.
@@ -13,6 +13,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
 #include "log.h"
 #endif
 
@@ -21,12 +22,37 @@
 #define MM_FREE(array) _mm_free(array)
 
 /** Word-aligned memory allocation for Intel's compiler */
-#define MM_MALLOC(size,alignment) _mm_alloc(size, alignment)
+#define MM_MALLOC(size,alignment) _mm_malloc(size, alignment)
 
 #else
 
+/** Word-aligned memory allocation for other compilers */
 #define MM_FREE(array) free(array)
-#define MM_MALLOC(size,alignment) malloc(size)
+
+/** Word-aligned memory allocation for other compilers */
+#define MM_MALLOC(size,alignment) aligned_malloc(size, alignment)
+
+#ifndef SWIG
+/**
+ * @brief Allocates memory aligned to some number of bytes.
+ * @details The memory may be released with the standard free(...) routine.
+ * @param size the number of bytes to allocate
+ * @param alignment the alignment in bytes (a power of two)
+ * @return a pointer to the aligned memory or NULL if allocation failed
+ */
+inline void* aligned_malloc(size_t size, size_t alignment) {
+
+  void* ptr;
+
+  if (alignment < sizeof(void*))
+    alignment = sizeof(void*);
+
+  if (posix_memalign(&ptr, alignment, size) != 0)
+    return NULL;
+
+  return ptr;
+}
+#endif
 
 #endif
 
@@ -68,6 +94,17 @@ private:
    *  row number and second index is column number */
   FP_PRECISION* _sigma_s;
 
+  /** For each destination group, the first origin group with a non-zero
+   *  scattering cross-section */
+  int* _sigma_s_begin;
+
+  /** For each destination group, one past the last origin group with a
+   *  non-zero scattering cross-section */
+  int* _sigma_s_end;
+
+  /** The number of non-zero entries in the scattering matrix */
+  int _num_sigma_s_nonzeros;
+
   /** An array of the fission cross-sections for each energy group */
   FP_PRECISION* _sigma_f;
 
@@ -114,6 +151,9 @@ public:
   FP_PRECISION* getSigmaT();
   FP_PRECISION* getSigmaA();
   FP_PRECISION* getSigmaS();
+  int* getSigmaSBegin();
+  int* getSigmaSEnd();
+  int getNumSigmaSNonZeros();
   FP_PRECISION* getSigmaF();
   FP_PRECISION* getNuSigmaF();
   FP_PRECISION* getChi();
@@ -161,6 +201,7 @@ public:
   void setDifTildeByGroup(double xs, int group, int surface);
 
   void checkSigmaT();
+  void computeScatteringBands();
   std::string toString();
   void printString();
 
@@ -1,4 +1,14 @@
 #include "Solver.h"
+
+
+/** The names of the quantities recorded for each source iteration in the
+ *  telemetry files, indexed by telemetryField */
+static const char* telemetry_names[NUM_TELEMETRY_FIELDS] = {
+  "k_eff", "residual", "normalize_time", "source_time", "sweep_time",
+  "add_source_time", "keff_time", "acceleration_time", "cmfd_time",
+  "segments_per_sec"};
+
+
 /**
  * @brief Constructor initializes an empty Solver class with array pointers
  *        set to NULL.
@@ -13,6 +23,7 @@ Solver::Solver(Geometry* geometry, TrackGenerator* track_generator) {
 
   /* Default values */
   _num_materials = 0;
+  _materials = NULL;
   _num_groups = 0;
   _num_azim = 0;
   _polar_times_groups = 0;
@@ -29,6 +40,13 @@ Solver::Solver(Geometry* geometry, TrackGenerator* track_generator) {
   _cmfd = NULL;
 
   _tracks = NULL;
+  _tot_num_segments = 0;
+  _segment_offsets = NULL;
+  _segment_lengths = NULL;
+  _segment_FSR_ids = NULL;
+  _segment_material_uids = NULL;
+  _segment_cmfd_surfaces_fwd = NULL;
+  _segment_cmfd_surfaces_bwd = NULL;
   _azim_weights = NULL;
   _polar_weights = NULL;
   _boundary_flux = NULL;
@@ -44,6 +62,38 @@ Solver::Solver(Geometry* geometry, TrackGenerator* track_generator) {
 
   _interpolate_exponential = true;
   _exp_table = NULL;
+  _exp_table_single = NULL;
+  _exp_table_target_error = 0.;
+  _exp_table_max_error = 0.;
+  _exp_table_order = 1;
+  _allow_single_exp_table = false;
+  _exp_table_max_tau = 0.;
+
+  _source_acceleration = NO_ACCELERATION;
+  _anderson_depth = 5;
+  _num_anderson_iterations = 0;
+  _anderson_next_index = 0;
+  _anderson_fluxes = NULL;
+  _anderson_swept_fluxes = NULL;
+  _anderson_residual = NULL;
+  _anderson_swept_diffs = NULL;
+  _anderson_residual_diffs = NULL;
+
+  _krylov_subspace_size = 10;
+
+  _telemetry_format = TELEMETRY_CSV;
+  _telemetry_file = NULL;
+
+  _checkpoint_fluxes = NULL;
+  _num_checkpoint_fluxes = 0;
+  _checkpoint_dif_tildes = NULL;
+  _num_checkpoint_dif_tildes = 0;
+  _checkpoint_keff = 1.0;
+  _checkpoint_iterations = 0;
+  _checkpoint_restart = false;
+  _iteration_offset = 0;
+  _checkpoint_fingerprint = 0;
+  _checkpoint_interval = 0;
 
   if (geometry != NULL){
     _cmfd = geometry->getCmfd();
@@ -59,6 +109,7 @@ Solver::Solver(Geometry* geometry, TrackGenerator* track_generator) {
   _two_times_num_polar = 2 * _num_polar;
 
   _num_iterations = 0;
+  _num_track_passes = 1;
   _source_convergence_thresh = 1E-3;
   _converged_source = false;
 
@@ -83,6 +134,9 @@ Solver::~Solver() {
   if (_FSR_materials != NULL)
     delete [] _FSR_materials;
 
+  if (_materials != NULL)
+    delete [] _materials;
+
   if (_polar_weights != NULL)
     delete [] _polar_weights;
 
@@ -113,6 +167,13 @@ Solver::~Solver() {
   if (_exp_table != NULL)
     delete [] _exp_table;
 
+  if (_exp_table_single != NULL)
+    delete [] _exp_table_single;
+
+  clearAcceleration();
+  clearCheckpoint();
+  closeTelemetryFile();
+
   if (_quad != NULL)
     delete _quad;
 }
@@ -254,6 +315,40 @@ bool Solver::isUsingExponentialIntrinsic() {
 }
 
 
+/**
+ * @brief Returns the bound on the maximum absolute error of the exponential
+ *        interpolation table.
+ * @details The bound includes the interpolation error, the error from
+ *          clamping large optical lengths and, for tables stored in single
+ *          precision, the rounding error. It is zero until the table is
+ *          built by Solver::convergeSource(...).
+ * @return the maximum absolute error of the interpolated exponentials
+ */
+double Solver::getExpTableMaxError() {
+  return _exp_table_max_error;
+}
+
+
+/**
+ * @brief Returns the order of the exponential table interpolation.
+ * @return the interpolation order (1 - linear, 2 - quadratic)
+ */
+int Solver::getExpTableOrder() {
+  return _exp_table_order;
+}
+
+
+/**
+ * @brief Returns the memory footprint of the exponential interpolation table.
+ * @return the table's memory footprint in MB
+ */
+double Solver::getExpTableMemory() {
+
+  int size = _exp_table_single != NULL ? sizeof(float) : sizeof(FP_PRECISION);
+  return double(_exp_table_size) * size / (1024. * 1024.);
+}
+
+
 /**
  * @brief Sets the Geometry for the Solver.
  * @details The Geometry must already have initialized FSR offset maps
@@ -315,6 +410,15 @@ void Solver::setTrackGenerator(TrackGenerator* track_generator) {
   _azim_weights = _track_generator->getAzimWeights();
   _tracks = new Track*[_tot_num_tracks];
 
+  /* Initialize pointers to the flat segment arrays */
+  _tot_num_segments = _track_generator->getNumSegments();
+  _segment_offsets = _track_generator->getSegmentOffsets();
+  _segment_lengths = _track_generator->getSegmentLengths();
+  _segment_FSR_ids = _track_generator->getSegmentFSRIds();
+  _segment_material_uids = _track_generator->getSegmentMaterialUids();
+  _segment_cmfd_surfaces_fwd = _track_generator->getSegmentCmfdSurfacesFwd();
+  _segment_cmfd_surfaces_bwd = _track_generator->getSegmentCmfdSurfacesBwd();
+
   /* Initialize the tracks array */
   int counter = 0;
 
@@ -390,6 +494,214 @@ void Solver::useExponentialIntrinsic() {
 }
 
 
+/**
+ * @brief Sets the target maximum absolute error of the exponential
+ *        interpolation table.
+ * @details The table's spacing and interpolation order are chosen to meet
+ *          this error for all polar angles with the smallest table. By
+ *          default the target error is 1% of the source convergence
+ *          threshold. The target error may be set in Python as follows:
+ *
+ * @code
+ *          solver.setExpTableMaxError(1E-6)
+ * @endcode
+ *
+ * @param max_error the target maximum absolute error
+ */
+void Solver::setExpTableMaxError(double max_error) {
+
+  if (max_error <= 0. || max_error >= 1.)
+    log_printf(ERROR, "Unable to set the exponential table maximum error "
+               "to %f since it is not between 0 and 1", max_error);
+
+  _exp_table_target_error = max_error;
+}
+
+
+/**
+ * @brief Sets whether the exponential interpolation table may be stored in
+ *        single precision.
+ * @details A single precision table halves the table's footprint in double
+ *          precision builds, but is only used if the rounding error is small
+ *          relative to the target maximum error of the table.
+ * @param single_precision whether to allow a single precision table
+ */
+void Solver::setExpTableSinglePrecision(bool single_precision) {
+  _allow_single_exp_table = single_precision;
+}
+
+
+/**
+ * @brief Returns the acceleration applied to the fluxes after each source
+ *        iteration.
+ * @return the source acceleration type (NO_ACCELERATION or
+ *         ANDERSON_ACCELERATION)
+ */
+sourceAccelerationType Solver::getSourceAcceleration() {
+  return _source_acceleration;
+}
+
+
+/**
+ * @brief Returns the maximum number of previous iterations used by Anderson
+ *        mixing.
+ * @return the Anderson mixing depth
+ */
+int Solver::getAndersonDepth() {
+  return _anderson_depth;
+}
+
+
+/**
+ * @brief Sets the acceleration applied to the fluxes after each source
+ *        iteration.
+ * @details With ANDERSON_ACCELERATION the FSR scalar fluxes and Track
+ *          boundary angular fluxes input to the next transport sweep are the
+ *          combination of the fluxes from the previous iterations which
+ *          minimizes the change in the fluxes over a transport sweep. This
+ *          may reduce the number of transport sweeps severalfold for
+ *          problems with a high dominance ratio which cannot use CMFD. The
+ *          acceleration is not used with CMFD. It may be selected in Python
+ *          as follows:
+ *
+ * @code
+ *          solver.setSourceAcceleration(openmoc.ANDERSON_ACCELERATION)
+ * @endcode
+ *
+ * @param acceleration the source acceleration type (NO_ACCELERATION or
+ *        ANDERSON_ACCELERATION)
+ */
+void Solver::setSourceAcceleration(sourceAccelerationType acceleration) {
+  _source_acceleration = acceleration;
+}
+
+
+/**
+ * @brief Sets the maximum number of previous iterations used by Anderson
+ *        mixing.
+ * @details Anderson mixing stores two copies of the scalar and boundary
+ *          fluxes for each previous iteration. The default depth is 5.
+ * @param depth the Anderson mixing depth (>0)
+ */
+void Solver::setAndersonDepth(int depth) {
+
+  if (depth <= 0)
+    log_printf(ERROR, "Unable to set the Anderson mixing depth to %d "
+               "since it is not a positive number", depth);
+
+  _anderson_depth = depth;
+}
+
+
+/**
+ * @brief Returns the maximum number of Krylov vectors for each Newton
+ *        iteration of Solver::convergeSourceKrylov(...).
+ * @return the Krylov subspace size
+ */
+int Solver::getKrylovSubspaceSize() {
+  return _krylov_subspace_size;
+}
+
+
+/**
+ * @brief Sets the maximum number of Krylov vectors for each Newton iteration
+ *        of Solver::convergeSourceKrylov(...).
+ * @details Each Krylov vector costs one transport sweep and the storage of
+ *          the scalar and boundary fluxes. The default size is 10.
+ * @param size the Krylov subspace size (>0)
+ */
+void Solver::setKrylovSubspaceSize(int size) {
+
+  if (size <= 0)
+    log_printf(ERROR, "Unable to set the Krylov subspace size to %d since "
+               "it is not a positive number", size);
+
+  _krylov_subspace_size = size;
+}
+
+
+/**
+ * @brief Returns the number of source iterations recorded by the last call
+ *        to Solver::convergeSource(...).
+ * @return the number of recorded source iterations
+ */
+int Solver::getNumTelemetryRecords() {
+  return _telemetry.size() / NUM_TELEMETRY_FIELDS;
+}
+
+
+/**
+ * @brief Copies a quantity recorded for each source iteration of the last
+ *        call to Solver::convergeSource(...) into an array.
+ * @details This is a helper method for SWIG to allow users to retrieve
+ *          the recorded quantities as a NumPy array. An example of how this
+ *          method can be called from Python is as follows:
+ *
+ * @code
+ *          num_records = solver.getNumTelemetryRecords()
+ *          sweep_times = solver.getTelemetry(openmoc.TELEMETRY_SWEEP_TIME,
+ *                                            num_records)
+ * @endcode
+ *
+ * @param field the recorded quantity
+ * @param telemetry an array to store the quantity for each source iteration
+ *        (implicitly passed in as a NumPy array from Python)
+ * @param num_records the number of source iterations passed in from Python
+ */
+void Solver::getTelemetry(telemetryField field, double* telemetry,
+                          int num_records) {
+
+  if (num_records > getNumTelemetryRecords())
+    log_printf(ERROR, "Unable to get %d telemetry records since only %d "
+               "source iterations were recorded", num_records,
+               getNumTelemetryRecords());
+
+  for (int i=0; i < num_records; i++)
+    telemetry[i] = _telemetry[i*NUM_TELEMETRY_FIELDS + field];
+}
+
+
+/**
+ * @brief Sets a file to which the quantities recorded for each source
+ *        iteration of Solver::convergeSource(...) are streamed.
+ * @details Each record is written and flushed at the end of its source
+ *          iteration, so that a long run may be followed while it is
+ *          solved. The file is overwritten by each call to
+ *          Solver::convergeSource(...). An empty filename stops the
+ *          streaming.
+ * @param filename the name of the file
+ * @param format the format of the file (TELEMETRY_CSV or TELEMETRY_JSON)
+ */
+void Solver::setTelemetryFile(const char* filename, telemetryFormat format) {
+  _telemetry_filename = filename;
+  _telemetry_format = format;
+}
+
+
+/**
+ * @brief Builds an array of the Geometry's Materials indexed by Material UID.
+ * @details The Track segments store the UID of the Material in which they
+ *          reside rather than a pointer to the Material. This method is
+ *          called by the Solver subclasses when the FSRs are initialized
+ *          and should not be called directly by the user. Subclasses may
+ *          override it to replace the Materials used by the solver.
+ */
+void Solver::initializeMaterials() {
+
+  std::map<int, Material*> materials = _geometry->getMaterials();
+  std::map<int, Material*>::iterator iter;
+
+  if (_materials != NULL)
+    delete [] _materials;
+
+  _num_materials = materials.size();
+  _materials = new Material*[_num_materials];
+
+  for (iter = materials.begin(); iter != materials.end(); ++iter)
+    _materials[iter->second->getUid()] = iter->second;
+}
+
+
 /**
  * @brief Initializes a Cmfd object for acceleratiion prior to source iteration.
  * @details Instantiates a dummy Cmfd object if one was not assigned to
@@ -422,9 +734,6 @@ void Solver::initializeCmfd(){
 void Solver::checkTrackSpacing() {
 
   int* FSR_segment_tallies = new int[_num_FSRs];
-  int num_segments;
-  segment* curr_segment;
-  segment* segments;
   Cell* cell;
 
   /* Set each tally to zero to begin with */
@@ -432,19 +741,10 @@ void Solver::checkTrackSpacing() {
   for (int r=0; r < _num_FSRs; r++)
     FSR_segment_tallies[r] = 0;
 
-  /* Iterate over all azimuthal angles, all tracks, and all Track segments
-   * and tally each segment in the corresponding FSR */
-  #pragma omp parallel for private (num_segments, curr_segment)
-  for (int i=0; i < _tot_num_tracks; i++) {
-
-    num_segments = _tracks[i]->getNumSegments();
-    segments = _tracks[i]->getSegments();
-
-    for (int s=0; s < num_segments; s++) {
-      curr_segment = &segments[s];
-      FSR_segment_tallies[curr_segment->_region_id]++;
-    }
-  }
+  /* Iterate over all Track segments and tally each segment in the
+   * corresponding FSR */
+  for (int s=0; s < _tot_num_segments; s++)
+    FSR_segment_tallies[_segment_FSR_ids[s]]++;
 
   /* Loop over all FSRs and if one FSR does not have tracks in it, print
    * error message to the screen and exit program */
@@ -462,6 +762,350 @@ void Solver::checkTrackSpacing() {
 }
 
 
+/**
+ * @brief Selects the transport sweep kernels to use for the number of
+ *        energy groups and polar angles.
+ * @details Solver subclasses with specialized sweep kernels override this
+ *          method. It is called by the Solver::convergeSource() method
+ *          after the polar quadrature and FSRs are initialized and should
+ *          not be called directly by the user.
+ */
+void Solver::initializeSweepKernels() {
+  return;
+}
+
+
+/**
+ * @brief Allocates the history of fluxes for the source acceleration.
+ * @details This method is called by the Solver::convergeSource() method and
+ *          should not be called directly by the user.
+ */
+void Solver::initializeAcceleration() {
+
+  clearAcceleration();
+
+  if (_source_acceleration == NO_ACCELERATION)
+    return;
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
+    log_printf(WARNING, "The source iteration will not be accelerated "
+               "since CMFD is used");
+    return;
+  }
+
+  long size = long(_num_FSRs) * _num_groups +
+              2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  _anderson_fluxes = new FP_PRECISION[size];
+  _anderson_swept_fluxes = new FP_PRECISION[size];
+  _anderson_residual = new FP_PRECISION[size];
+  _anderson_swept_diffs = new FP_PRECISION[_anderson_depth * size];
+  _anderson_residual_diffs = new FP_PRECISION[_anderson_depth * size];
+
+  log_printf(NORMAL, "Anderson mixing of %d iterations uses %.2f MB",
+             _anderson_depth, double(2 * _anderson_depth + 3) * size *
+             sizeof(FP_PRECISION) / (1024. * 1024.));
+}
+
+
+/**
+ * @brief Deletes the history of fluxes for the source acceleration.
+ */
+void Solver::clearAcceleration() {
+
+  _num_anderson_iterations = 0;
+  _anderson_next_index = 0;
+
+  if (_anderson_fluxes != NULL)
+    delete [] _anderson_fluxes;
+
+  if (_anderson_swept_fluxes != NULL)
+    delete [] _anderson_swept_fluxes;
+
+  if (_anderson_residual != NULL)
+    delete [] _anderson_residual;
+
+  if (_anderson_swept_diffs != NULL)
+    delete [] _anderson_swept_diffs;
+
+  if (_anderson_residual_diffs != NULL)
+    delete [] _anderson_residual_diffs;
+
+  _anderson_fluxes = NULL;
+  _anderson_swept_fluxes = NULL;
+  _anderson_residual = NULL;
+  _anderson_swept_diffs = NULL;
+  _anderson_residual_diffs = NULL;
+}
+
+
+/**
+ * @brief Accelerates the FSR scalar fluxes and Track boundary angular fluxes
+ *        computed by a transport sweep.
+ * @details Solver subclasses which store the fluxes on a device override
+ *          this method to apply Solver::andersonMix(...) to a host copy of
+ *          the fluxes. It is called by the Solver::convergeSource() method
+ *          after k-effective is computed for each iteration.
+ */
+void Solver::accelerateFluxes() {
+
+  if (_anderson_fluxes != NULL)
+    andersonMix(_scalar_flux, _boundary_flux);
+}
+
+
+/**
+ * @brief Replaces the fluxes computed by a transport sweep with the Anderson
+ *        mixing of the fluxes from the previous iterations.
+ * @details The fluxes \f$ x_i \f$ input to each transport sweep and the
+ *          fluxes \f$ g_i \f$ computed by it are normalized to unit sum of
+ *          the FSR scalar fluxes. The fluxes for the next transport sweep are
+ *          \f$ x_{i+1} = g_i - \sum_j \gamma_j \Delta g_j \f$, where
+ *          \f$ \Delta g_j \f$ are the differences between the swept fluxes
+ *          of successive previous iterations, and \f$ \gamma \f$ minimizes
+ *          the norm of the residual \f$ f_i - \sum_j \gamma_j \Delta f_j
+ *          \f$ for \f$ f_i = g_i - x_i \f$. The small least squares
+ *          problem is solved with the (regularized) normal equations. If the
+ *          mixed fluxes are negative anywhere the swept fluxes are used
+ *          instead and the mixing is restarted.
+ * @param scalar_flux the FSR scalar fluxes computed by the transport sweep
+ * @param boundary_flux the Track boundary angular fluxes computed by the
+ *        transport sweep
+ */
+void Solver::andersonMix(FP_PRECISION* scalar_flux,
+                         FP_PRECISION* boundary_flux) {
+
+  long num_FSR_fluxes = long(_num_FSRs) * _num_groups;
+  long size = num_FSR_fluxes + 2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  /* The scalar fluxes are followed by the boundary fluxes in the history */
+  FP_PRECISION* fluxes[2] = {scalar_flux, boundary_flux};
+  long offsets[2] = {0, num_FSR_fluxes};
+  long sizes[2] = {num_FSR_fluxes, size - num_FSR_fluxes};
+
+  /* Normalize the swept fluxes to unit sum of the scalar fluxes. The mixed
+   * fluxes are returned with the normalization of the swept fluxes. */
+  double flux_sum = 0.;
+
+  #pragma omp parallel for reduction(+:flux_sum) schedule(guided)
+  for (long i=0; i < num_FSR_fluxes; i++)
+    flux_sum += scalar_flux[i];
+
+  FP_PRECISION norm_factor = 1. / flux_sum;
+
+  /* Update the history with the swept fluxes and residuals */
+  int num_iters = _num_anderson_iterations;
+  int index = _anderson_next_index;
+  FP_PRECISION* swept_diffs = &_anderson_swept_diffs[index * size];
+  FP_PRECISION* residual_diffs = &_anderson_residual_diffs[index * size];
+
+  for (int b=0; b < 2; b++) {
+
+    FP_PRECISION* flux = fluxes[b];
+    long offset = offsets[b];
+
+    #pragma omp parallel for schedule(guided)
+    for (long i=0; i < sizes[b]; i++) {
+
+      long j = offset + i;
+      FP_PRECISION swept = flux[i] * norm_factor;
+
+      if (num_iters == 0) {
+        _anderson_fluxes[j] = swept;
+        continue;
+      }
+
+      FP_PRECISION residual = swept - _anderson_fluxes[j];
+
+      if (num_iters > 1) {
+        swept_diffs[j] = swept - _anderson_swept_fluxes[j];
+        residual_diffs[j] = residual - _anderson_residual[j];
+      }
+
+      _anderson_swept_fluxes[j] = swept;
+      _anderson_residual[j] = residual;
+      _anderson_fluxes[j] = swept;
+    }
+  }
+
+  _num_anderson_iterations++;
+
+  if (num_iters > 1)
+    _anderson_next_index = (index + 1) % _anderson_depth;
+
+  int num_diffs = std::min(num_iters - 1, _anderson_depth);
+
+  /* Use the swept fluxes until there are previous iterations to mix */
+  if (num_diffs <= 0)
+    return;
+
+  /* Compute the normal equations for the residual differences in one
+   * pass over the history */
+  int num_coeffs = num_diffs * (num_diffs + 1);
+  double* normal_eqs = new double[num_coeffs];
+
+  for (int k=0; k < num_coeffs; k++)
+    normal_eqs[k] = 0.;
+
+  #pragma omp parallel
+  {
+    double* thread_eqs = new double[num_coeffs];
+
+    for (int k=0; k < num_coeffs; k++)
+      thread_eqs[k] = 0.;
+
+    #pragma omp for schedule(guided)
+    for (long i=0; i < size; i++) {
+      for (int m=0; m < num_diffs; m++) {
+
+        double diff_m = _anderson_residual_diffs[m * size + i];
+
+        for (int n=0; n <= m; n++)
+          thread_eqs[m * (num_diffs+1) + n] +=
+               diff_m * _anderson_residual_diffs[n * size + i];
+
+        thread_eqs[m * (num_diffs+1) + num_diffs] +=
+             diff_m * _anderson_residual[i];
+      }
+    }
+
+    #pragma omp critical
+    {
+      for (int k=0; k < num_coeffs; k++)
+        normal_eqs[k] += thread_eqs[k];
+    }
+
+    delete [] thread_eqs;
+  }
+
+  /* Fill the upper triangle and regularize the diagonal */
+  double max_diag = 0.;
+
+  for (int m=0; m < num_diffs; m++) {
+    max_diag = std::max(max_diag, normal_eqs[m * (num_diffs+1) + m]);
+
+    for (int n=0; n < m; n++)
+      normal_eqs[n * (num_diffs+1) + m] = normal_eqs[m * (num_diffs+1) + n];
+  }
+
+  for (int m=0; m < num_diffs; m++)
+    normal_eqs[m * (num_diffs+1) + m] += 10. * max_diag *
+         std::numeric_limits<FP_PRECISION>::epsilon() + DBL_MIN;
+
+  /* Solve the normal equations by Gaussian elimination with pivoting */
+  double* gamma = new double[num_diffs];
+
+  for (int m=0; m < num_diffs; m++) {
+
+    int pivot = m;
+    for (int n=m+1; n < num_diffs; n++) {
+      if (fabs(normal_eqs[n * (num_diffs+1) + m]) >
+          fabs(normal_eqs[pivot * (num_diffs+1) + m]))
+        pivot = n;
+    }
+
+    for (int k=0; k <= num_diffs; k++)
+      std::swap(normal_eqs[m * (num_diffs+1) + k],
+                normal_eqs[pivot * (num_diffs+1) + k]);
+
+    for (int n=m+1; n < num_diffs; n++) {
+      double factor = normal_eqs[n * (num_diffs+1) + m] /
+                      normal_eqs[m * (num_diffs+1) + m];
+      for (int k=m; k <= num_diffs; k++)
+        normal_eqs[n * (num_diffs+1) + k] -=
+             factor * normal_eqs[m * (num_diffs+1) + k];
+    }
+  }
+
+  for (int m=num_diffs-1; m >= 0; m--) {
+    gamma[m] = normal_eqs[m * (num_diffs+1) + num_diffs];
+    for (int n=m+1; n < num_diffs; n++)
+      gamma[m] -= normal_eqs[m * (num_diffs+1) + n] * gamma[n];
+    gamma[m] /= normal_eqs[m * (num_diffs+1) + m];
+  }
+
+  /* Mix the fluxes from the previous iterations */
+  long num_negative = 0;
+
+  for (int b=0; b < 2; b++) {
+
+    FP_PRECISION* flux = fluxes[b];
+    long offset = offsets[b];
+
+    #pragma omp parallel for reduction(+:num_negative) schedule(guided)
+    for (long i=0; i < sizes[b]; i++) {
+
+      long j = offset + i;
+      FP_PRECISION mixed = _anderson_swept_fluxes[j];
+
+      for (int m=0; m < num_diffs; m++)
+        mixed -= gamma[m] * _anderson_swept_diffs[m * size + j];
+
+      num_negative += (mixed < 0.);
+      flux[i] = mixed * flux_sum;
+      _anderson_fluxes[j] = mixed;
+    }
+  }
+
+  /* Restart the mixing with the swept fluxes if any flux is negative */
+  if (num_negative > 0) {
+
+    log_printf(DEBUG, "Restarting Anderson mixing since %ld mixed fluxes "
+               "are negative", num_negative);
+
+    for (int b=0; b < 2; b++) {
+
+      FP_PRECISION* flux = fluxes[b];
+      long offset = offsets[b];
+
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < sizes[b]; i++) {
+        flux[i] = _anderson_swept_fluxes[offset + i] * flux_sum;
+        _anderson_fluxes[offset + i] = _anderson_swept_fluxes[offset + i];
+      }
+    }
+
+    _num_anderson_iterations = 1;
+    _anderson_next_index = 0;
+  }
+
+  delete [] normal_eqs;
+  delete [] gamma;
+}
+
+
+/**
+ * @brief Initializes the data structures for the transport sweeps and the
+ *        initial guess for the fluxes.
+ * @details This method is called by the Solver::convergeSource() and
+ *          Solver::convergeSourceKrylov() methods and should not be called
+ *          directly by the user.
+ */
+void Solver::initializeSourceConvergence() {
+
+  /* Initialize data structures */
+  initializePolarQuadrature();
+  initializeFluxArrays();
+  initializeSourceArrays();
+  buildExpInterpTable();
+  initializeFSRs();
+  initializeSweepKernels();
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    initializeCmfd();
+
+  /* Check that each FSR has at least one segment crossing it */
+  checkTrackSpacing();
+
+  /* Set scalar flux to unity for each region */
+  flattenFSRFluxes(1.0);
+  zeroTrackFluxes();
+
+  /* Start from the fluxes of a checkpoint if one was read */
+  startFromCheckpoint();
+}
+
+
 /**
  * @brief Computes keff by performing a series of transport sweep and
  *        source updates.
@@ -495,8 +1139,8 @@ FP_PRECISION Solver::convergeSource(int max_iterations) {
   /* Clear all timing data from a previous simulation run */
   clearTimerSplits();
 
-  /* Start the timer to record the total time to converge the source */
-  _timer->startTimer();
+  /* Open the scope of the total time to converge the source */
+  _timer->startScope("Total time to converge the source");
 
   /* Counter for the number of iterations to converge the source */
   _num_iterations = 0;
@@ -511,22 +1155,20 @@ FP_PRECISION Solver::convergeSource(int max_iterations) {
   FP_PRECISION residual_old = 1.0;
   FP_PRECISION keff_old = 1.0;
 
-  /* Initialize data structures */
-  initializePolarQuadrature();
-  initializeFluxArrays();
-  initializeSourceArrays();
-  buildExpInterpTable();
-  initializeFSRs();
+  /* Initialize data structures and the initial guess for the fluxes */
+  _timer->startScope("Solver initialization");
+  initializeSourceConvergence();
 
-  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
-    initializeCmfd();
+  /* Allocate the flux history for the source acceleration */
+  initializeAcceleration();
+  _timer->stopScope();
 
-  /* Check that each FSR has at least one segment crossing it */
-  checkTrackSpacing();
+  /* The quantities recorded for each iteration */
+  double record[NUM_TELEMETRY_FIELDS];
 
-  /* Set scalar flux to unity for each region */
-  flattenFSRFluxes(1.0);
-  zeroTrackFluxes();
+  _residual_vector.clear();
+  _telemetry.clear();
+  openTelemetryFile();
 
   /* Source iteration loop */
   for (int i=0; i < max_iterations; i++) {
@@ -534,31 +1176,72 @@ FP_PRECISION Solver::convergeSource(int max_iterations) {
     log_printf(NORMAL, "Iteration %d: \tk_eff = %1.6f"
                "\tres = %1.3E", i, _k_eff, residual);
 
+    _timer->startScope("Normalize fluxes");
     normalizeFluxes();    
+    record[TELEMETRY_NORMALIZE_TIME] = _timer->stopScope();
+
+    _timer->startScope("Compute FSR sources");
     residual = computeFSRSources();
+    record[TELEMETRY_SOURCE_TIME] = _timer->stopScope();
+
+    _timer->startScope("Transport sweep");
     transportSweep();
+    record[TELEMETRY_SWEEP_TIME] = _timer->stopScope();
+
+    _timer->startScope("Add source to scalar flux");
     addSourceToScalarFlux();
+    record[TELEMETRY_ADD_SOURCE_TIME] = _timer->stopScope();
+
+    record[TELEMETRY_KEFF_TIME] = 0.;
+    record[TELEMETRY_ACCELERATION_TIME] = 0.;
+    record[TELEMETRY_CMFD_TIME] = 0.;
 
     /* Solve CMFD diffusion problem and update MOC flux */
     if (_cmfd != NULL && _cmfd->isFluxUpdateOn()){
-      _k_eff = _cmfd->computeKeff(i);
+      _timer->startScope("CMFD solve");
+      _k_eff = _cmfd->computeKeff(_iteration_offset + _num_iterations);
+      record[TELEMETRY_CMFD_TIME] = _timer->stopScope();
       //updateBoundaryFlux();
     }
-    else
+    else {
+      _timer->startScope("Compute keff");
       computeKeff();
+      record[TELEMETRY_KEFF_TIME] = _timer->stopScope();
+
+      _timer->startScope("Source acceleration");
+      accelerateFluxes();
+      record[TELEMETRY_ACCELERATION_TIME] = _timer->stopScope();
+    }
+
+    record[TELEMETRY_KEFF] = _k_eff;
+    record[TELEMETRY_RESIDUAL] = residual;
+    record[TELEMETRY_SEGMENT_RATE] = 0.;
+    if (record[TELEMETRY_SWEEP_TIME] > 0.)
+      record[TELEMETRY_SEGMENT_RATE] = 2. * _tot_num_segments *
+          _num_track_passes / record[TELEMETRY_SWEEP_TIME];
+    recordTelemetry(record);
 
     _num_iterations++;
 
+    /* Write a checkpoint from which an interrupted run may be restarted */
+    if (_checkpoint_interval > 0 &&
+        _num_iterations % _checkpoint_interval == 0)
+      dumpCheckpoint(_checkpoint_filename.c_str());
+
+    /* Continue in full precision if the precision was reduced */
+    if (increasePrecision(residual))
+      continue;
+
     /* Check for convergence of the fission source distribution */
     if (i > 1 && residual < _source_convergence_thresh) {
-      _timer->stopTimer();
-      _timer->recordSplit("Total time to converge the source");
+      _timer->stopScope();
+      closeTelemetryFile();
       return _k_eff;
     }
   }
 
-  _timer->stopTimer();
-  _timer->recordSplit("Total time to converge the source");
+  _timer->stopScope();
+  closeTelemetryFile();
 
   log_printf(WARNING, "Unable to converge the source after %d iterations",
              max_iterations);
@@ -567,6 +1250,849 @@ FP_PRECISION Solver::convergeSource(int max_iterations) {
 }
 
 
+/**
+ * @brief Switches from reduced to full precision storage once the source
+ *        iteration is close to converged.
+ * @details Solver subclasses which store data in reduced precision during
+ *          the early source iterations override this method. By default the
+ *          precision is never changed, so the residual of the source on
+ *          this iteration is not used.
+ * @return whether the precision was increased
+ */
+bool Solver::increasePrecision(FP_PRECISION) {
+  return false;
+}
+
+
+/**
+ * @brief Returns the machine epsilon of the precision in which the fluxes
+ *        are stored.
+ * @details This sets the size of the finite differences in the Newton-Krylov
+ *          iterations, which must not be lost to the rounding of the stored
+ *          fluxes.
+ * @return the machine epsilon for the stored fluxes
+ */
+double Solver::getFluxEpsilon() {
+  return std::numeric_limits<FP_PRECISION>::epsilon();
+}
+
+
+/**
+ * @brief Copies the FSR scalar fluxes followed by the Track boundary angular
+ *        fluxes into an array.
+ * @details Solver subclasses which store the fluxes on a device override
+ *          this method to copy them to the host.
+ * @param fluxes the array to store the fluxes
+ */
+void Solver::getFluxes(FP_PRECISION* fluxes) {
+
+  long num_scalar_fluxes = long(_num_FSRs) * _num_groups;
+
+  memcpy(fluxes, _scalar_flux, num_scalar_fluxes * sizeof(FP_PRECISION));
+  memcpy(&fluxes[num_scalar_fluxes], _boundary_flux,
+         2 * long(_tot_num_tracks) * _polar_times_groups *
+         sizeof(FP_PRECISION));
+}
+
+
+/**
+ * @brief Sets the FSR scalar fluxes and Track boundary angular fluxes from
+ *        an array.
+ * @details Solver subclasses which store the fluxes on a device override
+ *          this method to copy them from the host.
+ * @param fluxes the FSR scalar fluxes followed by the boundary fluxes
+ */
+void Solver::setFluxes(FP_PRECISION* fluxes) {
+
+  long num_scalar_fluxes = long(_num_FSRs) * _num_groups;
+
+  memcpy(_scalar_flux, fluxes, num_scalar_fluxes * sizeof(FP_PRECISION));
+  memcpy(_boundary_flux, &fluxes[num_scalar_fluxes],
+         2 * long(_tot_num_tracks) * _polar_times_groups *
+         sizeof(FP_PRECISION));
+}
+
+
+/**
+ * @brief Applies one source iteration to a state of the fluxes and
+ *        k-effective.
+ * @details The state is the FSR scalar fluxes, followed by the Track boundary
+ *          angular fluxes and k-effective. The fluxes are normalized, the
+ *          source is computed and a transport sweep is performed, after which
+ *          k-effective is updated. The swept fluxes are scaled to unit mean
+ *          scalar flux so that the map from the state to the swept state is
+ *          independent of the scale of the fluxes. The unscaled swept fluxes
+ *          remain in the Solver. This method is called by the
+ *          Solver::convergeSourceKrylov() method and should not be called
+ *          directly by the user.
+ * @param state the fluxes and k-effective for the source iteration
+ * @param swept_state the array to store the swept fluxes and k-effective
+ */
+void Solver::applySourceIteration(FP_PRECISION* state,
+                                  FP_PRECISION* swept_state) {
+
+  long num_scalar_fluxes = long(_num_FSRs) * _num_groups;
+  long num_fluxes = num_scalar_fluxes +
+                    2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  setFluxes(state);
+  _k_eff = state[num_fluxes];
+
+  normalizeFluxes();
+  computeFSRSources();
+
+  _timer->startScope("Transport sweep");
+  transportSweep();
+  _timer->stopScope();
+
+  addSourceToScalarFlux();
+  computeKeff();
+
+  _num_iterations++;
+
+  getFluxes(swept_state);
+
+  /* Scale the swept fluxes to unit mean scalar flux */
+  double flux_sum = 0.;
+
+  #pragma omp parallel for reduction(+:flux_sum) schedule(guided)
+  for (long i=0; i < num_scalar_fluxes; i++)
+    flux_sum += swept_state[i];
+
+  FP_PRECISION norm_factor = num_scalar_fluxes / flux_sum;
+
+  #pragma omp parallel for schedule(guided)
+  for (long i=0; i < num_fluxes; i++)
+    swept_state[i] *= norm_factor;
+
+  swept_state[num_fluxes] = _k_eff;
+}
+
+
+/**
+ * @brief Computes the residual between the scalar fluxes of a state and
+ *        of the state after a source iteration.
+ * @details The residual is the root mean square of the relative change in
+ *          the scalar flux in each FSR and energy group, similar to the
+ *          residual of the source returned by computeFSRSources().
+ * @param state the fluxes and k-effective input to the source iteration
+ * @param swept_state the fluxes and k-effective after the source iteration
+ * @return the residual of the scalar fluxes
+ */
+FP_PRECISION Solver::computeStateResidual(FP_PRECISION* state,
+                                          FP_PRECISION* swept_state) {
+
+  long num_scalar_fluxes = long(_num_FSRs) * _num_groups;
+  double residual = 0.;
+
+  #pragma omp parallel for reduction(+:residual) schedule(guided)
+  for (long i=0; i < num_scalar_fluxes; i++) {
+    if (fabs(swept_state[i]) > 1E-10)
+      residual += pow((swept_state[i] - state[i]) / swept_state[i], 2);
+  }
+
+  return sqrt(residual / num_scalar_fluxes);
+}
+
+
+/**
+ * @brief Computes keff with Newton iterations on the source iteration, each
+ *        of which is solved with a Krylov method.
+ * @details This is an alternative to Solver::convergeSource(...) which
+ *          treats one source iteration (a source update and transport sweep)
+ *          as a nonlinear operator \f$ P \f$ on the state \f$ u \f$ of the
+ *          FSR scalar fluxes, Track boundary angular fluxes and k-effective.
+ *          The fixed point \f$ P(u) = u \f$ is found with Newton's method,
+ *          where each Newton step solves \f$ (J_P - I) \delta = u - P(u) \f$
+ *          with GMRES to a relative tolerance of KRYLOV_FORCING_TERM. The
+ *          product of the Jacobian \f$ J_P \f$ with a vector is computed with
+ *          a finite difference, which costs one transport sweep, so no
+ *          matrix is formed. A step which does not reduce the residual is
+ *          replaced by a source iteration. The first KRYLOV_INITIAL_ITERATIONS
+ *          source iterations give the initial guess.
+ *
+ *          Convergence is checked with the root mean square relative change
+ *          in the FSR scalar fluxes over a source iteration. The number of
+ *          iterations returned by Solver::getNumIterations() is the number
+ *          of transport sweeps. CMFD is not used. The method may be called
+ *          from Python as follows:
+ *
+ * @code
+ *          max_sweeps = 1000
+ *          solver.convergeSourceKrylov(max_sweeps)
+ * @endcode
+ *
+ * @param max_iterations the maximum number of transport sweeps to allow
+ * @return the value of the computed eigenvalue \f$ k_{eff} \f$
+ */
+FP_PRECISION Solver::convergeSourceKrylov(int max_iterations) {
+
+  /* Error checking */
+  if (_geometry == NULL)
+    log_printf(ERROR, "The Solver is unable to converge the source "
+               "since it does not contain a Geometry");
+
+  if (_track_generator == NULL)
+    log_printf(ERROR, "The Solver is unable to converge the source "
+               "since it does not contain a TrackGenerator");
+
+  log_printf(NORMAL, "Converging the source with Newton-Krylov "
+             "iterations...");
+
+  /* Clear all timing data from a previous simulation run */
+  clearTimerSplits();
+
+  /* Open the scope of the total time to converge the source */
+  _timer->startScope("Total time to converge the source");
+
+  _num_iterations = 0;
+  _k_eff = 1.0;
+
+  /* The source iterations are not recorded for the Newton-Krylov solve */
+  _residual_vector.clear();
+  _telemetry.clear();
+
+  /* Initialize data structures and the initial guess for the fluxes */
+  initializeSourceConvergence();
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn())
+    log_printf(WARNING, "CMFD is not used by the Newton-Krylov iterations");
+
+  long num_fluxes = long(_num_FSRs) * _num_groups +
+                    2 * long(_tot_num_tracks) * _polar_times_groups;
+  long size = num_fluxes + 1;
+  int num_vectors = _krylov_subspace_size;
+
+  /* Allocate the states and the Krylov basis */
+  FP_PRECISION* state = new FP_PRECISION[size];
+  FP_PRECISION* swept_state = new FP_PRECISION[size];
+  FP_PRECISION* trial_state = new FP_PRECISION[size];
+  FP_PRECISION* swept_trial_state = new FP_PRECISION[size];
+  FP_PRECISION* basis = new FP_PRECISION[(num_vectors+1) * size];
+
+  log_printf(NORMAL, "Newton-Krylov iterations use %.2f MB",
+             double(num_vectors + 5) * size * sizeof(FP_PRECISION) /
+             (1024. * 1024.));
+
+  /* The Hessenberg matrix, Givens rotations and right hand side for GMRES */
+  double* hessenberg = new double[(num_vectors+1) * num_vectors];
+  double* cosines = new double[num_vectors];
+  double* sines = new double[num_vectors];
+  double* rhs = new double[num_vectors+1];
+
+  /* The relative size of the finite difference for the Jacobian */
+  double fd_size = sqrt(getFluxEpsilon());
+
+  /* Apply source iterations for the initial guess */
+  getFluxes(state);
+  state[num_fluxes] = _k_eff;
+  applySourceIteration(state, swept_state);
+
+  for (int i=0; i < KRYLOV_INITIAL_ITERATIONS; i++) {
+    std::swap(state, swept_state);
+    applySourceIteration(state, swept_state);
+  }
+
+  FP_PRECISION residual = computeStateResidual(state, swept_state);
+
+  /* Continue in full precision if the precision was reduced */
+  if (increasePrecision(residual)) {
+    fd_size = sqrt(getFluxEpsilon());
+    applySourceIteration(state, swept_state);
+    residual = computeStateResidual(state, swept_state);
+  }
+
+  /* Newton iterations */
+  while (residual >= _source_convergence_thresh &&
+         _num_iterations + 2 < max_iterations) {
+
+    log_printf(NORMAL, "Iteration %d: \tk_eff = %1.6f"
+               "\tres = %1.3E", _num_iterations, _k_eff, residual);
+
+    /* The first Krylov vector is the normalized Newton residual */
+    double beta = 0.;
+    double state_norm = 0.;
+
+    #pragma omp parallel for reduction(+:beta,state_norm) schedule(guided)
+    for (long i=0; i < size; i++) {
+      basis[i] = state[i] - swept_state[i];
+      beta += double(basis[i]) * basis[i];
+      state_norm += double(state[i]) * state[i];
+    }
+
+    beta = sqrt(beta);
+    state_norm = sqrt(state_norm);
+
+    #pragma omp parallel for schedule(guided)
+    for (long i=0; i < size; i++)
+      basis[i] /= beta;
+
+    rhs[0] = beta;
+    int num_krylov = 0;
+
+    /* GMRES iterations with the Arnoldi process */
+    for (int j=0; j < num_vectors; j++) {
+
+      FP_PRECISION* vector = &basis[j * size];
+      FP_PRECISION* next_vector = &basis[(j+1) * size];
+
+      /* Compute the product of the Jacobian with the vector */
+      FP_PRECISION epsilon = fd_size * (1. + state_norm);
+
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < size; i++)
+        trial_state[i] = state[i] + epsilon * vector[i];
+
+      applySourceIteration(trial_state, swept_trial_state);
+
+      #pragma omp parallel for schedule(guided)
+      for (long i=0; i < size; i++)
+        next_vector[i] = (swept_trial_state[i] - swept_state[i]) / epsilon -
+                         vector[i];
+
+      /* Orthogonalize with modified Gram-Schmidt */
+      for (int k=0; k <= j; k++) {
+
+        double dot = 0.;
+        FP_PRECISION* basis_k = &basis[k * size];
+
+        #pragma omp parallel for reduction(+:dot) schedule(guided)
+        for (long i=0; i < size; i++)
+          dot += double(next_vector[i]) * basis_k[i];
+
+        #pragma omp parallel for schedule(guided)
+        for (long i=0; i < size; i++)
+          next_vector[i] -= dot * basis_k[i];
+
+        hessenberg[k * num_vectors + j] = dot;
+      }
+
+      double norm = 0.;
+
+      #pragma omp parallel for reduction(+:norm) schedule(guided)
+      for (long i=0; i < size; i++)
+        norm += double(next_vector[i]) * next_vector[i];
+
+      norm = sqrt(norm);
+      hessenberg[(j+1) * num_vectors + j] = norm;
+
+      if (norm > 0.) {
+        #pragma omp parallel for schedule(guided)
+        for (long i=0; i < size; i++)
+          next_vector[i] /= norm;
+      }
+
+      /* Apply the previous Givens rotations to the new column */
+      for (int k=0; k < j; k++) {
+        double h_k = hessenberg[k * num_vectors + j];
+        double h_k1 = hessenberg[(k+1) * num_vectors + j];
+        hessenberg[k * num_vectors + j] = cosines[k] * h_k + sines[k] * h_k1;
+        hessenberg[(k+1) * num_vectors + j] = -sines[k] * h_k +
+                                              cosines[k] * h_k1;
+      }
+
+      /* Compute the Givens rotation to eliminate the subdiagonal */
+      double h_j = hessenberg[j * num_vectors + j];
+      double h_j1 = hessenberg[(j+1) * num_vectors + j];
+      double radius = sqrt(h_j * h_j + h_j1 * h_j1);
+
+      cosines[j] = h_j / radius;
+      sines[j] = h_j1 / radius;
+      hessenberg[j * num_vectors + j] = radius;
+      hessenberg[(j+1) * num_vectors + j] = 0.;
+
+      rhs[j+1] = -sines[j] * rhs[j];
+      rhs[j] *= cosines[j];
+
+      num_krylov = j + 1;
+
+      /* Stop if the linear residual is small enough or the sweeps needed
+       * for the Newton update are all that remain */
+      if (fabs(rhs[j+1]) <= KRYLOV_FORCING_TERM * beta || norm == 0. ||
+          _num_iterations + 2 >= max_iterations)
+        break;
+    }
+
+    /* Solve the upper triangular system for the Krylov coefficients */
+    for (int k=num_krylov-1; k >= 0; k--) {
+      for (int n=k+1; n < num_krylov; n++)
+        rhs[k] -= hessenberg[k * num_vectors + n] * rhs[n];
+      rhs[k] /= hessenberg[k * num_vectors + k];
+    }
+
+    /* Compute the Newton update */
+    #pragma omp parallel for schedule(guided)
+    for (long i=0; i < size; i++) {
+      trial_state[i] = state[i];
+      for (int k=0; k < num_krylov; k++)
+        trial_state[i] += rhs[k] * basis[k * size + i];
+    }
+
+    applySourceIteration(trial_state, swept_trial_state);
+
+    double trial_beta = 0.;
+
+    #pragma omp parallel for reduction(+:trial_beta) schedule(guided)
+    for (long i=0; i < size; i++)
+      trial_beta += pow(double(swept_trial_state[i]) - trial_state[i], 2);
+
+    /* Accept the Newton update if it reduced the residual, and otherwise
+     * apply a source iteration */
+    if (sqrt(trial_beta) < beta) {
+      std::swap(state, trial_state);
+      std::swap(swept_state, swept_trial_state);
+    }
+    else {
+      log_printf(DEBUG, "Replacing a Newton update with a source iteration "
+                 "since it did not reduce the residual");
+      std::swap(state, swept_state);
+      applySourceIteration(state, swept_state);
+    }
+
+    residual = computeStateResidual(state, swept_state);
+
+    /* Sweep the current state again in full precision if the precision
+     * was reduced */
+    if (increasePrecision(residual)) {
+      fd_size = sqrt(getFluxEpsilon());
+      applySourceIteration(state, swept_state);
+      residual = computeStateResidual(state, swept_state);
+    }
+  }
+
+  delete [] state;
+  delete [] swept_state;
+  delete [] trial_state;
+  delete [] swept_trial_state;
+  delete [] basis;
+  delete [] hessenberg;
+  delete [] cosines;
+  delete [] sines;
+  delete [] rhs;
+
+  _timer->stopScope();
+
+  if (residual >= _source_convergence_thresh)
+    log_printf(WARNING, "Unable to converge the source after %d transport "
+               "sweeps", _num_iterations);
+
+  return _k_eff;
+}
+
+
+/**
+ * @brief Adds an array of bytes to a 64-bit FNV-1a hash.
+ * @param hash the hash to update
+ * @param data a pointer to the bytes
+ * @param size the number of bytes
+ */
+static void fnv1a_hash(unsigned long long& hash, const void* data,
+                       size_t size) {
+
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+  for (size_t i=0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+
+/**
+ * @brief Computes a fingerprint of the Tracks, FSRs and energy groups to
+ *        check that a checkpoint was written for the same problem.
+ * @details The fingerprint is a hash of the problem dimensions, the polar
+ *          quadrature and the flat segment arrays. It does not depend on the
+ *          Materials' cross-sections, so that a checkpoint may be used to
+ *          start the solution of a perturbed problem.
+ * @return the fingerprint
+ */
+unsigned long long Solver::computeFingerprint() {
+
+  unsigned long long hash = 14695981039346656037ULL;
+
+  int sizes[7] = {int(sizeof(FP_PRECISION)), _num_FSRs, _num_groups,
+                  int(_quadrature_type), _num_polar, _tot_num_tracks,
+                  _tot_num_segments};
+
+  fnv1a_hash(hash, sizes, sizeof(sizes));
+  fnv1a_hash(hash, _segment_offsets, (_tot_num_tracks + 1) * sizeof(int));
+  fnv1a_hash(hash, _segment_lengths,
+             size_t(_tot_num_segments) * sizeof(FP_PRECISION));
+  fnv1a_hash(hash, _segment_FSR_ids, size_t(_tot_num_segments) * sizeof(int));
+
+  return hash;
+}
+
+
+/**
+ * @brief Writes the fluxes, k-effective and number of source iterations to
+ *        a binary checkpoint file.
+ * @details The number of source iterations includes those of any
+ *          checkpoint the source iteration was started from.
+ * @details The checkpoint holds the FSR scalar fluxes, the Track boundary
+ *          angular fluxes and the CMFD surface diffusion coefficient
+ *          corrections in FP_PRECISION, with a fingerprint of the Tracks
+ *          and FSRs. The CMFD mesh fluxes are not needed since they are
+ *          computed from the FSR scalar fluxes in each CMFD solve. The
+ *          checkpoint is first written to a temporary file which then
+ *          replaces it, so that an interrupted write does not destroy the
+ *          previous checkpoint. A checkpoint may be written after the
+ *          source has been converged from Python as follows:
+ *
+ * @code
+ *          solver.convergeSource(max_iters)
+ *          solver.dumpCheckpoint('pin-cell.checkpoint')
+ * @endcode
+ *
+ * @param filename the name of the checkpoint file
+ */
+void Solver::dumpCheckpoint(const char* filename) {
+
+  if (_scalar_flux == NULL)
+    log_printf(ERROR, "Unable to dump a checkpoint to %s since the fluxes "
+               "have not yet been computed", filename);
+
+  long num_fluxes = long(_num_FSRs) * _num_groups +
+                    2 * long(_tot_num_tracks) * _polar_times_groups;
+  FP_PRECISION* fluxes = new FP_PRECISION[num_fluxes];
+  getFluxes(fluxes);
+
+  long num_dif_tildes = 0;
+  FP_PRECISION* dif_tildes = NULL;
+
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn()) {
+    num_dif_tildes = _cmfd->getNumDifTildes();
+    dif_tildes = new FP_PRECISION[num_dif_tildes];
+    _cmfd->getDifTildes(dif_tildes);
+  }
+
+  char magic[8] = "OPENMOC";
+  int version = CHECKPOINT_VERSION;
+  int precision = sizeof(FP_PRECISION);
+  unsigned long long fingerprint = computeFingerprint();
+  double k_eff = _k_eff;
+  int num_iterations = _iteration_offset + _num_iterations;
+
+  std::string temp_filename = std::string(filename) + ".tmp";
+  FILE* out = fopen(temp_filename.c_str(), "wb");
+
+  if (out == NULL)
+    log_printf(ERROR, "Unable to open %s to dump a checkpoint",
+               temp_filename.c_str());
+
+  size_t count = fwrite(magic, sizeof(char), 8, out);
+  count += fwrite(&version, sizeof(int), 1, out);
+  count += fwrite(&precision, sizeof(int), 1, out);
+  count += fwrite(&fingerprint, sizeof(unsigned long long), 1, out);
+  count += fwrite(&k_eff, sizeof(double), 1, out);
+  count += fwrite(&num_iterations, sizeof(int), 1, out);
+  count += fwrite(&num_fluxes, sizeof(long), 1, out);
+  count += fwrite(fluxes, sizeof(FP_PRECISION), num_fluxes, out);
+  count += fwrite(&num_dif_tildes, sizeof(long), 1, out);
+  count += fwrite(dif_tildes, sizeof(FP_PRECISION), num_dif_tildes, out);
+
+  delete [] fluxes;
+
+  if (dif_tildes != NULL)
+    delete [] dif_tildes;
+
+  if (fclose(out) != 0 || count != size_t(15 + num_fluxes + num_dif_tildes))
+    log_printf(ERROR, "Unable to write the checkpoint to %s",
+               temp_filename.c_str());
+
+  if (rename(temp_filename.c_str(), filename) != 0)
+    log_printf(ERROR, "Unable to replace the checkpoint %s with %s",
+               filename, temp_filename.c_str());
+
+  log_printf(NORMAL, "Dumped a checkpoint after %d iterations to %s",
+             num_iterations, filename);
+}
+
+
+/**
+ * @brief Reads a binary checkpoint file from which to start the source
+ *        iteration.
+ * @details The fluxes, k-effective and number of source iterations in the
+ *          checkpoint are the initial guess for each following call to
+ *          Solver::convergeSource() or Solver::convergeSourceKrylov(), until
+ *          Solver::clearCheckpoint() is called. The checkpoint is only used
+ *          if it was written for the same Tracks, FSRs and energy groups,
+ *          but the Materials may differ. This may be called from Python to
+ *          restart an interrupted run, whose iteration count is continued,
+ *          or to warm start a perturbed problem from the solution of the
+ *          unperturbed one, for which Solver::getNumIterations() counts
+ *          only the new source iterations, as follows:
+ *
+ * @code
+ *          solver.readCheckpoint('pin-cell.checkpoint', restart=True)
+ *          solver.convergeSource(max_iters)
+ *
+ *          solver.readCheckpoint('unperturbed.checkpoint')
+ *          solver.convergeSource(max_iters)
+ * @endcode
+ *
+ * @param filename the name of the checkpoint file
+ * @param restart whether to continue the iteration count of the run which
+ *        wrote the checkpoint (false by default)
+ */
+void Solver::readCheckpoint(const char* filename, bool restart) {
+
+  FILE* in = fopen(filename, "rb");
+
+  if (in == NULL)
+    log_printf(ERROR, "Unable to open the checkpoint %s", filename);
+
+  char magic[8];
+  int version;
+  int precision;
+  double k_eff;
+  long num_fluxes;
+
+  size_t count = fread(magic, sizeof(char), 8, in);
+
+  if (count != 8 || strncmp(magic, "OPENMOC", 8) != 0) {
+    fclose(in);
+    log_printf(ERROR, "Unable to read %s since it is not a checkpoint",
+               filename);
+  }
+
+  count = fread(&version, sizeof(int), 1, in);
+  count += fread(&precision, sizeof(int), 1, in);
+
+  if (count != 2 || version != CHECKPOINT_VERSION ||
+      precision != sizeof(FP_PRECISION)) {
+    fclose(in);
+    log_printf(ERROR, "Unable to read the checkpoint %s since it was not "
+               "written in version %d of the format in %d byte precision",
+               filename, CHECKPOINT_VERSION, int(sizeof(FP_PRECISION)));
+  }
+
+  clearCheckpoint();
+  _checkpoint_restart = restart;
+
+  count = fread(&_checkpoint_fingerprint, sizeof(unsigned long long), 1, in);
+  count += fread(&k_eff, sizeof(double), 1, in);
+  count += fread(&_checkpoint_iterations, sizeof(int), 1, in);
+  count += fread(&num_fluxes, sizeof(long), 1, in);
+
+  if (count == 4 && num_fluxes > 0) {
+    _checkpoint_fluxes = new FP_PRECISION[num_fluxes];
+    _num_checkpoint_fluxes = num_fluxes;
+    _checkpoint_keff = k_eff;
+    count += fread(_checkpoint_fluxes, sizeof(FP_PRECISION), num_fluxes, in);
+    count += fread(&_num_checkpoint_dif_tildes, sizeof(long), 1, in);
+  }
+
+  if (count == size_t(5 + _num_checkpoint_fluxes) &&
+      _num_checkpoint_dif_tildes > 0) {
+    _checkpoint_dif_tildes = new FP_PRECISION[_num_checkpoint_dif_tildes];
+    count += fread(_checkpoint_dif_tildes, sizeof(FP_PRECISION),
+                   _num_checkpoint_dif_tildes, in);
+  }
+
+  fclose(in);
+
+  if (count != size_t(5 + _num_checkpoint_fluxes +
+                      _num_checkpoint_dif_tildes) ||
+      _num_checkpoint_fluxes == 0) {
+    clearCheckpoint();
+    log_printf(ERROR, "Unable to read the fluxes from the checkpoint %s",
+               filename);
+  }
+
+  log_printf(NORMAL, "Read a checkpoint with k_eff = %1.6f after %d "
+             "iterations from %s", _checkpoint_keff, _checkpoint_iterations,
+             filename);
+}
+
+
+/**
+ * @brief Deletes the fluxes read from a checkpoint so that the source
+ *        iteration starts from a flat flux.
+ */
+void Solver::clearCheckpoint() {
+
+  if (_checkpoint_fluxes != NULL)
+    delete [] _checkpoint_fluxes;
+
+  if (_checkpoint_dif_tildes != NULL)
+    delete [] _checkpoint_dif_tildes;
+
+  _checkpoint_fluxes = NULL;
+  _num_checkpoint_fluxes = 0;
+  _checkpoint_dif_tildes = NULL;
+  _num_checkpoint_dif_tildes = 0;
+  _checkpoint_keff = 1.0;
+  _checkpoint_iterations = 0;
+  _checkpoint_restart = false;
+  _checkpoint_fingerprint = 0;
+}
+
+
+/**
+ * @brief Sets the file and the number of source iterations between the
+ *        checkpoints written by Solver::convergeSource().
+ * @details Each checkpoint replaces the previous one. A run which is
+ *          interrupted may be restarted with Solver::readCheckpoint().
+ * @param filename the name of the checkpoint file
+ * @param num_iterations the number of source iterations between
+ *        checkpoints, or zero to write no checkpoints
+ */
+void Solver::setCheckpointInterval(const char* filename, int num_iterations) {
+
+  if (num_iterations < 0)
+    log_printf(ERROR, "Unable to write a checkpoint every %d iterations "
+               "since it is negative", num_iterations);
+
+  _checkpoint_filename = filename;
+  _checkpoint_interval = num_iterations;
+}
+
+
+/**
+ * @brief Sets the fluxes and k-effective to those read from a checkpoint.
+ * @details This method is called at the end of the initialization for the
+ *          source iteration and does nothing unless a checkpoint was read.
+ *          If the checkpoint was written for different Tracks, FSRs or
+ *          energy groups, the source iteration starts from a flat flux.
+ *          A restart continues the checkpoint's iteration count. A warm
+ *          start counts only its own iterations, but the CMFD relaxation
+ *          is continued from the checkpoint's count in either case.
+ */
+void Solver::startFromCheckpoint() {
+
+  _iteration_offset = 0;
+
+  if (_checkpoint_fluxes == NULL)
+    return;
+
+  long num_fluxes = long(_num_FSRs) * _num_groups +
+                    2 * long(_tot_num_tracks) * _polar_times_groups;
+
+  if (_num_checkpoint_fluxes != num_fluxes ||
+      _checkpoint_fingerprint != computeFingerprint()) {
+    log_printf(WARNING, "Starting from a flat flux since the checkpoint was "
+               "written for different Tracks, FSRs or energy groups");
+    return;
+  }
+
+  setFluxes(_checkpoint_fluxes);
+  _k_eff = _checkpoint_keff;
+
+  if (_checkpoint_restart)
+    _num_iterations = _checkpoint_iterations;
+  else
+    _iteration_offset = _checkpoint_iterations;
+
+  /* Continue the under-relaxation of the CMFD diffusion coefficients */
+  if (_cmfd != NULL && _cmfd->isFluxUpdateOn() &&
+      _num_checkpoint_dif_tildes == _cmfd->getNumDifTildes())
+    _cmfd->setDifTildes(_checkpoint_dif_tildes);
+
+  log_printf(NORMAL, "Starting from the checkpoint with k_eff = %1.6f after "
+             "%d iterations", _k_eff, _checkpoint_iterations);
+}
+
+
+/**
+ * @brief Opens the file to which the quantities recorded for each source
+ *        iteration are streamed and writes its header.
+ * @details This method does nothing unless a file was set with
+ *          Solver::setTelemetryFile(...).
+ */
+void Solver::openTelemetryFile() {
+
+  closeTelemetryFile();
+
+  if (_telemetry_filename.empty())
+    return;
+
+  _telemetry_file = fopen(_telemetry_filename.c_str(), "w");
+
+  if (_telemetry_file == NULL)
+    log_printf(ERROR, "Unable to open %s to stream the telemetry",
+               _telemetry_filename.c_str());
+
+  if (_telemetry_format == TELEMETRY_JSON)
+    fprintf(_telemetry_file, "[");
+
+  else {
+    fprintf(_telemetry_file, "iteration");
+
+    for (int f=0; f < NUM_TELEMETRY_FIELDS; f++)
+      fprintf(_telemetry_file, ",%s", telemetry_names[f]);
+
+    fprintf(_telemetry_file, "\n");
+    fflush(_telemetry_file);
+  }
+}
+
+
+/**
+ * @brief Stores the quantities recorded for a source iteration and streams
+ *        them to the telemetry file if one is open.
+ * @param record the NUM_TELEMETRY_FIELDS quantities for the iteration,
+ *        indexed by telemetryField
+ */
+void Solver::recordTelemetry(double* record) {
+
+  _residual_vector.push_back(record[TELEMETRY_RESIDUAL]);
+  _telemetry.insert(_telemetry.end(), record, record + NUM_TELEMETRY_FIELDS);
+
+  if (_telemetry_file == NULL)
+    return;
+
+  if (_telemetry_format == TELEMETRY_JSON) {
+    fprintf(_telemetry_file, "%s\n  {\"iteration\": %d",
+            _telemetry.size() > NUM_TELEMETRY_FIELDS ? "," : "",
+            _num_iterations);
+
+    /* JSON has no representation of NaN or infinity, such as the residual
+     * of the first iteration after a flat flux guess, so they are null */
+    char value[32];
+
+    for (int f=0; f < NUM_TELEMETRY_FIELDS; f++) {
+      snprintf(value, sizeof(value), "%.9E", record[f]);
+
+      if (strpbrk(value, "NnIi") != NULL)
+        fprintf(_telemetry_file, ", \"%s\": null", telemetry_names[f]);
+      else
+        fprintf(_telemetry_file, ", \"%s\": %s", telemetry_names[f], value);
+    }
+
+    fprintf(_telemetry_file, "}");
+  }
+
+  else {
+    fprintf(_telemetry_file, "%d", _num_iterations);
+
+    for (int f=0; f < NUM_TELEMETRY_FIELDS; f++)
+      fprintf(_telemetry_file, ",%.9E", record[f]);
+
+    fprintf(_telemetry_file, "\n");
+  }
+
+  fflush(_telemetry_file);
+}
+
+
+/**
+ * @brief Completes and closes the telemetry file if one is open.
+ */
+void Solver::closeTelemetryFile() {
+
+  if (_telemetry_file == NULL)
+    return;
+
+  if (_telemetry_format == TELEMETRY_JSON)
+    fprintf(_telemetry_file, "\n]\n");
+
+  fclose(_telemetry_file);
+  _telemetry_file = NULL;
+}
+
+
 /**
  * @brief Deletes the Timer's timing entries for each timed code section
  *        code in the source convergence loop.
@@ -611,6 +2137,22 @@ void Solver::printTimerReport() {
   msg_string.resize(53, '.');
   log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), time_per_integration);
 
+  /* Time per transport sweep */
+  double sweep_time = _timer->getSplit("Total time to converge the source"
+                                       "/Transport sweep");
+  double time_per_sweep = sweep_time / _num_iterations;
+  msg_string = "Transport sweep time per iteration";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(), time_per_sweep);
+
+  /* Segments swept per second in both Track directions */
+  double segments_per_sec = 0.;
+  if (time_per_sweep > 0.)
+    segments_per_sec = 2. * num_segments * _num_track_passes / time_per_sweep;
+  msg_string = "Segments swept per second";
+  msg_string.resize(53, '.');
+  log_printf(RESULT, "%s%1.4E", msg_string.c_str(), segments_per_sec);
+
   set_separator_character('-');
   log_printf(SEPARATOR, "-");
 
@@ -11,6 +11,12 @@
 #ifdef __cplusplus
 #define _USE_MATH_DEFINES
 #include <math.h>
+#include <float.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <algorithm>
+#include <limits>
 #include "Timer.h"
 #include "Quadrature.h"
 #include "TrackGenerator.h"
@@ -63,6 +69,89 @@
 #define ONE_OVER_FOUR_PI 0.0795774715
 
 
+/**
+ * @enum sourceAccelerationType
+ * @brief The acceleration applied to the fluxes after each source iteration.
+ */
+enum sourceAccelerationType {
+  /** Plain source (power) iteration */
+  NO_ACCELERATION,
+
+  /** Anderson mixing of the fluxes from the previous source iterations */
+  ANDERSON_ACCELERATION
+};
+
+
+/**
+ * @enum telemetryField
+ * @brief The quantities recorded for each source iteration of
+ *        Solver::convergeSource().
+ */
+enum telemetryField {
+  /** The approximation to k-effective at the end of the iteration */
+  TELEMETRY_KEFF,
+
+  /** The residual between the old and new FSR sources */
+  TELEMETRY_RESIDUAL,
+
+  /** The time to normalize the fluxes (seconds) */
+  TELEMETRY_NORMALIZE_TIME,
+
+  /** The time to compute the FSR sources (seconds) */
+  TELEMETRY_SOURCE_TIME,
+
+  /** The time for the transport sweep (seconds) */
+  TELEMETRY_SWEEP_TIME,
+
+  /** The time to add the source to the FSR scalar fluxes (seconds) */
+  TELEMETRY_ADD_SOURCE_TIME,
+
+  /** The time to compute k-effective (seconds) */
+  TELEMETRY_KEFF_TIME,
+
+  /** The time for the source acceleration (seconds) */
+  TELEMETRY_ACCELERATION_TIME,
+
+  /** The time for the CMFD solve and flux update (seconds) */
+  TELEMETRY_CMFD_TIME,
+
+  /** The number of segments swept per second in both Track directions,
+   *  counting each pass over the Tracks of a Gauss-Seidel sweep */
+  TELEMETRY_SEGMENT_RATE
+};
+
+
+/** The number of quantities recorded for each source iteration */
+#define NUM_TELEMETRY_FIELDS 10
+
+
+/**
+ * @enum telemetryFormat
+ * @brief The format of the file to which the quantities recorded for each
+ *        source iteration are streamed.
+ */
+enum telemetryFormat {
+  /** Comma separated values with a header line */
+  TELEMETRY_CSV,
+
+  /** A JSON array with an object for each source iteration */
+  TELEMETRY_JSON
+};
+
+
+/** The number of source iterations which precede the Newton iterations of
+ *  Solver::convergeSourceKrylov() to give an initial guess */
+#define KRYLOV_INITIAL_ITERATIONS 5
+
+/** The reduction in the residual at which the Krylov solve for each Newton
+ *  iteration of Solver::convergeSourceKrylov() stops */
+#define KRYLOV_FORCING_TERM 1E-1
+
+/** The version of the binary checkpoint format written by
+ *  Solver::dumpCheckpoint() */
+#define CHECKPOINT_VERSION 1
+
+
 /**
  * @class Solver Solver.h "src/Solver.h"
  * @brief This is an abstract base class which different Solver subclasses
@@ -99,6 +188,9 @@ protected:
   /** The number of Materials */
   int _num_materials;
 
+  /** The Material pointers indexed by Material UID */
+  Material** _materials;
+
   /** A pointer to a polar quadrature */
   Quadrature* _quad;
 
@@ -123,6 +215,27 @@ protected:
   /** The total number of Tracks */
   int _tot_num_tracks;
 
+  /** The total number of Track segments */
+  int _tot_num_segments;
+
+  /** The offset of each Track's first segment into the segment arrays */
+  int* _segment_offsets;
+
+  /** The lengths (cm) of all Track segments */
+  FP_PRECISION* _segment_lengths;
+
+  /** The FSR IDs of all Track segments */
+  int* _segment_FSR_ids;
+
+  /** The Material UIDs of all Track segments */
+  int* _segment_material_uids;
+
+  /** The CMFD Mesh surfaces crossed by the end point of each segment */
+  int* _segment_cmfd_surfaces_fwd;
+
+  /** The CMFD Mesh surfaces crossed by the start point of each segment */
+  int* _segment_cmfd_surfaces_bwd;
+
   /** The weights for each azimuthal angle */
   FP_PRECISION* _azim_weights;
 
@@ -167,15 +280,31 @@ protected:
   /** The current iteration's approximation to k-effective */
   FP_PRECISION _k_eff;
 
-  /** An array of k-effective at each iteration */
+  /** An array of the source residual at each iteration */
   std::vector<FP_PRECISION> _residual_vector;
 
+  /** The quantities recorded for each iteration of the last source
+   *  convergence, with NUM_TELEMETRY_FIELDS values for each iteration */
+  std::vector<double> _telemetry;
+
+  /** The file to which the recorded quantities are streamed, if any */
+  std::string _telemetry_filename;
+
+  /** The format of the file to which the recorded quantities are streamed */
+  telemetryFormat _telemetry_format;
+
+  /** The open file to which the recorded quantities are streamed */
+  FILE* _telemetry_file;
+
   /** The total leakage across vacuum boundaries */
   FP_PRECISION _leakage;
 
   /** The number of source iterations needed to reach convergence */
   int _num_iterations;
 
+  /** The number of passes over all Tracks in each transport sweep */
+  int _num_track_passes;
+
   /** Whether or not the Solver has converged the source */
   bool _converged_source;
 
@@ -186,9 +315,31 @@ protected:
    *  to comptue the exponential in the transport equation */
   bool _interpolate_exponential;
 
-  /** The exponential linear interpolation table */
+  /** The exponential interpolation table */
   FP_PRECISION* _exp_table;
 
+  /** The exponential interpolation table stored in single precision */
+  float* _exp_table_single;
+
+  /** The target maximum absolute error of the exponential interpolation
+   *  table, or zero to derive it from the source convergence threshold */
+  double _exp_table_target_error;
+
+  /** The bound on the maximum absolute error of the exponential
+   *  interpolation table which was built */
+  double _exp_table_max_error;
+
+  /** The order of the interpolation (1 - linear, 2 - quadratic) */
+  int _exp_table_order;
+
+  /** Whether or not to store the exponential interpolation table in single
+   *  precision if its error budget allows it */
+  bool _allow_single_exp_table;
+
+  /** The maximum optical length in the exponential interpolation table.
+   *  The exponential is within the table's error of one beyond it. */
+  FP_PRECISION _exp_table_max_tau;
+
   /** The size of the exponential linear interpolation table */
   int _exp_table_size;
 
@@ -201,6 +352,79 @@ protected:
   /** The inverse spacing for the exponential linear interpolation table */
   FP_PRECISION _inverse_exp_table_spacing;
 
+  /** The acceleration applied to the fluxes after each source iteration */
+  sourceAccelerationType _source_acceleration;
+
+  /** The maximum number of previous iterations used by Anderson mixing */
+  int _anderson_depth;
+
+  /** The number of source iterations accelerated since Anderson mixing
+   *  was initialized or restarted */
+  int _num_anderson_iterations;
+
+  /** The index in the Anderson history for the next iteration's
+   *  differences, which replace those of the oldest iteration */
+  int _anderson_next_index;
+
+  /** The fluxes (scalar fluxes followed by the boundary fluxes) which were
+   *  the input to the last transport sweep, normalized to unit sum of the
+   *  scalar fluxes */
+  FP_PRECISION* _anderson_fluxes;
+
+  /** The normalized fluxes computed by the previous transport sweep */
+  FP_PRECISION* _anderson_swept_fluxes;
+
+  /** The difference between the normalized fluxes computed by and input to
+   *  the previous transport sweep */
+  FP_PRECISION* _anderson_residual;
+
+  /** The differences between the swept fluxes of successive iterations */
+  FP_PRECISION* _anderson_swept_diffs;
+
+  /** The differences between the residuals of successive iterations */
+  FP_PRECISION* _anderson_residual_diffs;
+
+  /** The maximum number of Krylov vectors for each Newton iteration */
+  int _krylov_subspace_size;
+
+  /** The fluxes (scalar fluxes followed by the boundary fluxes) read from a
+   *  checkpoint, from which the source iteration is started */
+  FP_PRECISION* _checkpoint_fluxes;
+
+  /** The number of fluxes read from the checkpoint */
+  long _num_checkpoint_fluxes;
+
+  /** The CMFD surface diffusion coefficient corrections read from the
+   *  checkpoint */
+  FP_PRECISION* _checkpoint_dif_tildes;
+
+  /** The number of CMFD corrections read from the checkpoint */
+  long _num_checkpoint_dif_tildes;
+
+  /** The k-effective read from the checkpoint */
+  FP_PRECISION _checkpoint_keff;
+
+  /** The number of source iterations read from the checkpoint */
+  int _checkpoint_iterations;
+
+  /** Whether the source iteration is a restart of the run which wrote the
+   *  checkpoint, whose iteration count is then continued */
+  bool _checkpoint_restart;
+
+  /** The number of source iterations read from the checkpoint for a warm
+   *  start, which are not counted in _num_iterations but continue the
+   *  CMFD relaxation */
+  int _iteration_offset;
+
+  /** The fingerprint of the Tracks and FSRs read from the checkpoint */
+  unsigned long long _checkpoint_fingerprint;
+
+  /** The file to which checkpoints are written during source iteration */
+  std::string _checkpoint_filename;
+
+  /** The number of source iterations between checkpoints, or zero */
+  int _checkpoint_interval;
+
   /** A timer to record timing data for a simulation */
   Timer* _timer;
 
@@ -209,6 +433,7 @@ protected:
 
   int round_to_int(float x);
   int round_to_int(double x);
+  FP_PRECISION interpolateExponential(int index, int p, FP_PRECISION delta);
 
   /**
    * @brief Creates a polar quadrature object for the Solver.
@@ -238,8 +463,32 @@ protected:
 
   virtual void initializeCmfd();
 
+  virtual void initializeMaterials();
+
   virtual void checkTrackSpacing();
 
+  virtual void initializeSweepKernels();
+
+  void initializeAcceleration();
+  void clearAcceleration();
+  virtual void accelerateFluxes();
+  void andersonMix(FP_PRECISION* scalar_flux, FP_PRECISION* boundary_flux);
+  void initializeSourceConvergence();
+
+  virtual void getFluxes(FP_PRECISION* fluxes);
+  virtual void setFluxes(FP_PRECISION* fluxes);
+  virtual double getFluxEpsilon();
+  virtual bool increasePrecision(FP_PRECISION residual);
+  void applySourceIteration(FP_PRECISION* state, FP_PRECISION* swept_state);
+  FP_PRECISION computeStateResidual(FP_PRECISION* state,
+                                    FP_PRECISION* swept_state);
+  void openTelemetryFile();
+  void recordTelemetry(double* record);
+  void closeTelemetryFile();
+
+  unsigned long long computeFingerprint();
+  void startFromCheckpoint();
+
   /**
    * @brief Zero each Track's boundary fluxes for each energy group and polar
    *        angle in the "forward" and "reverse" directions.
@@ -315,6 +564,14 @@ public:
   bool isUsingDoublePrecision();
   bool isUsingExponentialInterpolation();
   bool isUsingExponentialIntrinsic();
+  double getExpTableMaxError();
+  int getExpTableOrder();
+  double getExpTableMemory();
+  sourceAccelerationType getSourceAcceleration();
+  int getAndersonDepth();
+  int getKrylovSubspaceSize();
+  int getNumTelemetryRecords();
+  void getTelemetry(telemetryField field, double* telemetry, int num_records);
 
   /**
    * @brief Returns the scalar flux for a FSR and energy group.
@@ -346,8 +603,21 @@ public:
 
   void useExponentialInterpolation();
   void useExponentialIntrinsic();
+  void setExpTableMaxError(double max_error);
+  void setExpTableSinglePrecision(bool single_precision);
+  void setSourceAcceleration(sourceAccelerationType acceleration);
+  void setAndersonDepth(int depth);
+  void setKrylovSubspaceSize(int size);
+  void setTelemetryFile(const char* filename,
+                        telemetryFormat format=TELEMETRY_CSV);
 
   virtual FP_PRECISION convergeSource(int max_iterations);
+  virtual FP_PRECISION convergeSourceKrylov(int max_iterations);
+
+  void dumpCheckpoint(const char* filename);
+  void readCheckpoint(const char* filename, bool restart=false);
+  void clearCheckpoint();
+  void setCheckpointInterval(const char* filename, int num_iterations);
 
 /**
  * @brief Computes the volume-weighted, energy integrated fission rate in
@@ -367,7 +637,7 @@ public:
  */
   virtual void computeFSRFissionRates(double* fission_rates, int num_FSRs) =0;
 
-  void printTimerReport();
+  virtual void printTimerReport();
 };
 
 
@@ -391,4 +661,39 @@ inline int Solver::round_to_int(double x) {
 }
 
 
+/**
+ * @brief Evaluates the exponential in the transport equation,
+ *        \f$ 1 - exp(-\frac{\tau}{sin(\theta)}) \f$, from the
+ *        interpolation table.
+ * @details The table holds the Taylor series of the exponential to first
+ *          or second order at each point for each polar angle. The caller
+ *          finds the nearest table point to the optical length, clamped to
+ *          the table's maximum optical length, and the distance from it.
+ * @param index the index of the nearest table point
+ * @param p the polar angle index
+ * @param delta the optical length minus that of the nearest table point
+ * @return the interpolated exponential
+ */
+inline FP_PRECISION Solver::interpolateExponential(int index, int p,
+                                                   FP_PRECISION delta) {
+
+  int i = (index * _num_polar + p) * (_exp_table_order + 1);
+
+  if (_exp_table_single != NULL) {
+    if (_exp_table_order == 2)
+      return _exp_table_single[i] + delta * (_exp_table_single[i+1] +
+             delta * _exp_table_single[i+2]);
+    else
+      return _exp_table_single[i] + delta * _exp_table_single[i+1];
+  }
+  else {
+    if (_exp_table_order == 2)
+      return _exp_table[i] + delta * (_exp_table[i+1] +
+             delta * _exp_table[i+2]);
+    else
+      return _exp_table[i] + delta * _exp_table[i+1];
+  }
+}
+
+
 #endif /* SOLVER_H_ */
@@ -195,6 +195,9 @@ protected:
   /** The Plane is a friend of class Circle */
   friend class Circle;
 
+  /** The Plane is a friend of class CompiledGeometry */
+  friend class CompiledGeometry;
+
 public:
 
   Plane(const double A, const double B, const double C, const int id=0);
@@ -327,6 +330,9 @@ private:
   /** The Circle is a friend of the Plane class */
   friend class Plane;
 
+  /** The Circle is a friend of the CompiledGeometry class */
+  friend class CompiledGeometry;
+
 public:
   Circle(const double x, const double y, const double radius, const int id=0);
 
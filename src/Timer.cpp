@@ -1,44 +1,280 @@
 #include "Timer.h"
 
 
-std::map<std::string, double> Timer::_timer_splits;
-std::vector<double> Timer::_start_times;
+std::vector<timerThread*> Timer::_threads;
+std::map<std::string, timerSplit> Timer::_exited_splits;
+std::vector<std::string> Timer::_split_paths;
 
 
 /**
- * @brief Starts the Timer.
- * @details This method is similar to starting a stopwatch.
+ * @struct timerThread
+ * @brief The open scopes, running timers and splits of one thread.
+ * @details Each thread registers its state with the Timer when it first
+ *          uses the Timer, and merges its splits into those of the exited
+ *          threads when it exits.
  */
-void Timer::startTimer() {
+struct timerThread {
+
+  /** The paths and start times of the thread's open scopes */
+  std::vector< std::pair<std::string, double> > _scopes;
+
+  /** The start times of the thread's running timers */
+  std::vector<double> _start_times;
+
+  /** The time elapsed (seconds) for the thread's current split */
+  double _elapsed_time;
+
+  /** The thread's splits indexed by path */
+  std::map<std::string, timerSplit> _splits;
+
+  /**
+   * @brief Registers the thread's state with the Timer.
+   */
+  timerThread() {
+    _elapsed_time = 0.;
+
+    #pragma omp critical (timer)
+    Timer::_threads.push_back(this);
+  }
+
+  /**
+   * @brief Merges the thread's splits into those of the exited threads.
+   */
+  ~timerThread() {
+
+    #pragma omp critical (timer)
+    {
+      std::map<std::string, timerSplit>::iterator iter;
+
+      for (iter = _splits.begin(); iter != _splits.end(); ++iter) {
+        Timer::_exited_splits[iter->first].first += iter->second.first;
+        Timer::_exited_splits[iter->first].second += iter->second.second;
+      }
+
+      for (size_t i=0; i < Timer::_threads.size(); i++) {
+        if (Timer::_threads[i] == this) {
+          Timer::_threads.erase(Timer::_threads.begin() + i);
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Adds a time to the split at a path within the open scopes.
+   * @param name the name of the split
+   * @param time the time (seconds)
+   */
+  void recordSplit(const std::string& name, double time) {
+    timerSplit& split = _splits[path(name)];
+    split.first += time;
+    split.second++;
+  }
+
+  /**
+   * @brief Returns the path of a name within the thread's open scopes.
+   * @param name the name of a scope or split
+   * @return the path of the name
+   */
+  std::string path(const std::string& name) {
+    if (_scopes.empty())
+      return name;
+    else
+      return _scopes.back().first + TIMER_PATH_SEPARATOR + name;
+  }
+};
+
+
+/**
+ * @struct timerNode
+ * @brief A split and the splits nested within it, used to report the
+ *        Timer's splits as a tree.
+ */
+struct timerNode {
+
+  /** Whether the split was recorded or only has nested splits */
+  bool _recorded;
 
-  double start_time = omp_get_wtime();
-  _start_times.push_back(start_time);
-  _running = true;
+  /** The split's time (seconds) and count */
+  timerSplit _split;
 
-  return;
+  /** The nested splits indexed by name */
+  std::map<std::string, timerNode> _children;
+
+  timerNode() : _recorded(false), _split(0., 0) { }
+};
+
+
+/**
+ * @brief Builds the tree of nested splits from the splits indexed by path.
+ * @param splits the splits indexed by path
+ * @param root the root of the tree, whose children are the outer splits
+ */
+static void build_tree(std::map<std::string, timerSplit>& splits,
+                       timerNode& root) {
+
+  std::map<std::string, timerSplit>::iterator iter;
+
+  for (iter = splits.begin(); iter != splits.end(); ++iter) {
+
+    timerNode* node = &root;
+    std::string name;
+    std::stringstream path(iter->first);
+
+    while (std::getline(path, name, TIMER_PATH_SEPARATOR))
+      node = &node->_children[name];
+
+    node->_recorded = true;
+    node->_split = iter->second;
+  }
 }
 
 
 /**
- * @brief Stops the Timer.
- * @details This method is similar to stopping a stopwatch.
+ * @brief Appends the paths of the recorded splits in a tree to a vector
+ *        with each split before those nested within it.
+ * @param node the node of the tree
+ * @param path the path of the node
+ * @param paths the vector of paths
  */
-void Timer::stopTimer() {
+static void list_paths(timerNode& node, const std::string& path,
+                       std::vector<std::string>& paths) {
+
+  std::map<std::string, timerNode>::iterator iter;
+
+  if (node._recorded)
+    paths.push_back(path);
+
+  for (iter = node._children.begin(); iter != node._children.end(); ++iter) {
+    if (path.empty())
+      list_paths(iter->second, iter->first, paths);
+    else
+      list_paths(iter->second, path + TIMER_PATH_SEPARATOR + iter->first,
+                 paths);
+  }
+}
+
 
-  if (_running) {
+/**
+ * @brief Prints the splits nested within a node of the tree of splits.
+ * @param node the node of the tree
+ * @param depth the nesting depth of the node's children
+ */
+static void print_tree(timerNode& node, int depth) {
+
+  std::map<std::string, timerNode>::iterator iter;
+
+  for (iter = node._children.begin(); iter != node._children.end(); ++iter) {
+
+    std::string msg_string = std::string(2 * depth, ' ') + iter->first;
+    msg_string.resize(53, '.');
+
+    if (iter->second._recorded)
+      log_printf(RESULT, "%s%1.4E sec", msg_string.c_str(),
+                 iter->second._split.first);
+    else
+      log_printf(RESULT, "%s", msg_string.c_str());
+
+    print_tree(iter->second, depth + 1);
+  }
+}
+
+
+/**
+ * @brief Writes the splits nested within a node of the tree of splits as
+ *        the members of a JSON object.
+ * @param file the file
+ * @param node the node of the tree
+ * @param depth the nesting depth of the node's children
+ */
+static void write_json_tree(FILE* file, timerNode& node, int depth) {
+
+  std::map<std::string, timerNode>::iterator iter;
+  std::string indent(2 * depth, ' ');
+
+  for (iter = node._children.begin(); iter != node._children.end(); ++iter) {
+
+    if (iter != node._children.begin())
+      fprintf(file, ",\n");
+
+    fprintf(file, "%s\"%s\": {", indent.c_str(), iter->first.c_str());
+
+    if (iter->second._recorded)
+      fprintf(file, "\"time\": %.9E, \"count\": %d",
+              iter->second._split.first, iter->second._split.second);
+
+    if (!iter->second._children.empty()) {
+      fprintf(file, "%s\"splits\": {\n",
+              iter->second._recorded ? ", " : "");
+      write_json_tree(file, iter->second, depth + 1);
+      fprintf(file, "\n%s}", indent.c_str());
+    }
+
+    fprintf(file, "}");
+  }
+}
+
+
+/**
+ * @brief Returns the Timer state of the calling thread.
+ * @return a pointer to the thread's state
+ */
+timerThread* Timer::getThread() {
+  static thread_local timerThread thread;
+  return &thread;
+}
+
+
+/**
+ * @brief Merges the splits of all threads.
+ * @return the splits indexed by path
+ */
+std::map<std::string, timerSplit> Timer::mergeSplits() {
 
-    double end_time = omp_get_wtime();
-    double start_time = _start_times.back();
+  std::map<std::string, timerSplit> splits;
 
-    _elapsed_time = end_time - start_time;
+  #pragma omp critical (timer)
+  {
+    splits = _exited_splits;
 
-    if (_start_times.empty())
-      _running = false;
+    std::map<std::string, timerSplit>::iterator iter;
 
-    _start_times.pop_back();
+    for (size_t i=0; i < _threads.size(); i++) {
+      for (iter = _threads[i]->_splits.begin();
+           iter != _threads[i]->_splits.end(); ++iter) {
+        splits[iter->first].first += iter->second.first;
+        splits[iter->first].second += iter->second.second;
+      }
+    }
   }
 
-  return;
+  return splits;
+}
+
+
+/**
+ * @brief Starts the Timer.
+ * @details This method is similar to starting a stopwatch. The Timers of
+ *          each thread run independently.
+ */
+void Timer::startTimer() {
+  getThread()->_start_times.push_back(omp_get_wtime());
+}
+
+
+/**
+ * @brief Stops the Timer.
+ * @details This method is similar to stopping a stopwatch.
+ */
+void Timer::stopTimer() {
+
+  timerThread* thread = getThread();
+
+  if (thread->_start_times.empty())
+    return;
+
+  thread->_elapsed_time = omp_get_wtime() - thread->_start_times.back();
+  thread->_start_times.pop_back();
 }
 
 
@@ -46,44 +282,154 @@ void Timer::stopTimer() {
  * @brief Records a message corresponding to a time for the current split.
  * @details When this method is called it assumes that the Timer has been
  *          stopped and has the current time for the process corresponding
- *          to the message.
+ *          to the message. The split is nested within the scopes which are
+ *          open on this thread.
  * @param msg a msg corresponding to this time split
  */
 void Timer::recordSplit(const char* msg) {
-
-  double time = getTime();
-  std::string msg_string = std::string(msg);
-
-  if (_timer_splits.find(msg_string) != _timer_splits.end())
-    _timer_splits.at(msg_string) += time;
-  else
-    _timer_splits.insert(std::pair<std::string, double>(msg_string, time));
+  timerThread* thread = getThread();
+  thread->recordSplit(std::string(msg), thread->_elapsed_time);
 }
 
 
 /**
- * @brief Returns the time elapsed from startTimer() to stopTimer().
+ * @brief Returns the time elapsed from startTimer() to stopTimer() on this
+ *        thread.
  * @return the elapsed time in seconds
  */
 double Timer::getTime() {
-  return _elapsed_time;
+  return getThread()->_elapsed_time;
+}
+
+
+/**
+ * @brief Opens a scope nested within the scopes which are open on this
+ *        thread.
+ * @details Each scope must be closed with Timer::stopScope() on the same
+ *          thread, or by a TimerScope guard. The scopes may be used in
+ *          Python as follows:
+ *
+ * @code
+ *          openmoc.Timer.startScope('Geometry construction')
+ *          ...
+ *          openmoc.Timer.stopScope()
+ * @endcode
+ *
+ * @param name the name of the scope
+ */
+void Timer::startScope(const char* name) {
+
+  timerThread* thread = getThread();
+  std::string path = thread->path(std::string(name));
+
+  thread->_scopes.push_back(std::make_pair(path, omp_get_wtime()));
 }
 
 
 /**
- * @brief Returns the time associated with a particular split.
+ * @brief Closes the innermost scope which is open on this thread and adds
+ *        its time to its split.
+ * @return the time (seconds) since the scope was opened
+ */
+double Timer::stopScope() {
+
+  double end_time = omp_get_wtime();
+  timerThread* thread = getThread();
+
+  if (thread->_scopes.empty())
+    log_printf(ERROR, "Unable to stop a Timer scope since no scope is open");
+
+  std::string path = thread->_scopes.back().first;
+  double time = end_time - thread->_scopes.back().second;
+
+  thread->_scopes.pop_back();
+
+  timerSplit& split = thread->_splits[path];
+  split.first += time;
+  split.second++;
+
+  return time;
+}
+
+
+/**
+ * @brief Returns the time associated with a particular split summed over
+ *        all threads.
  * @details If the split does not exist, returns 0.
- * @param msg the message tag for the split
+ * @param path the path of the split, such as
+ *        "Total time to converge the source/Transport sweep"
  * @return the time recorded for the split (seconds)
  */
-double Timer::getSplit(const char* msg) {
+double Timer::getSplit(const char* path) {
+
+  std::map<std::string, timerSplit> splits = mergeSplits();
+  std::map<std::string, timerSplit>::iterator iter;
 
-  std::string msg_string = std::string(msg);
+  iter = splits.find(std::string(path));
 
-  if (_timer_splits.find(msg_string) == _timer_splits.end())
+  if (iter == splits.end())
     return 0.0;
   else
-    return _timer_splits.at(msg_string);
+    return iter->second.first;
+}
+
+
+/**
+ * @brief Returns the number of times a split was recorded by all threads.
+ * @details If the split does not exist, returns 0.
+ * @param path the path of the split
+ * @return the number of times the split was recorded
+ */
+int Timer::getSplitCount(const char* path) {
+
+  std::map<std::string, timerSplit> splits = mergeSplits();
+  std::map<std::string, timerSplit>::iterator iter;
+
+  iter = splits.find(std::string(path));
+
+  if (iter == splits.end())
+    return 0;
+  else
+    return iter->second.second;
+}
+
+
+/**
+ * @brief Returns the number of splits recorded by all threads.
+ * @details This also lists the paths of the splits for
+ *          Timer::getSplitPath(...), with each split before those nested
+ *          within it.
+ * @return the number of splits
+ */
+int Timer::getNumSplits() {
+
+  std::map<std::string, timerSplit> splits = mergeSplits();
+  timerNode root;
+
+  build_tree(splits, root);
+
+  _split_paths.clear();
+  list_paths(root, std::string(), _split_paths);
+
+  return _split_paths.size();
+}
+
+
+/**
+ * @brief Returns the path of a split listed by the last call to
+ *        Timer::getNumSplits().
+ * @details This is a helper method for the openmoc.process module to
+ *          retrieve the splits as nested dictionaries in Python.
+ * @param index the index of the split
+ * @return the path of the split
+ */
+const char* Timer::getSplitPath(int index) {
+
+  if (index < 0 || index >= (int)_split_paths.size())
+    log_printf(ERROR, "Unable to get the path of split %d since %d splits "
+               "were listed", index, (int)_split_paths.size());
+
+  return _split_paths[index].c_str();
 }
 
 
@@ -91,42 +437,97 @@ double Timer::getSplit(const char* msg) {
  * @brief Prints the times and messages for each split to the console.
  * @details This method will loop through all of the Timer's splits and print a
  *          formatted message string (80 characters in length) to the console
- *          with the message and the time corresponding to that message.
+ *          with the message and the time corresponding to that message. The
+ *          splits nested within a scope are indented below it.
  */
 void Timer::printSplits() {
 
-  std::string curr_msg;
-  double curr_split;
-  std::map<std::string, double>::iterator iter;
+  std::map<std::string, timerSplit> splits = mergeSplits();
+  timerNode root;
 
-  for (iter = _timer_splits.begin(); iter != _timer_splits.end(); ++iter) {
+  build_tree(splits, root);
+  print_tree(root, 0);
+}
 
-    std::stringstream formatted_msg;
 
-    curr_msg = (*iter).first;
-    curr_split = (*iter).second;
+/**
+ * @brief Exports the splits of all threads to a file.
+ * @details The CSV format has one row for each split with its path, time
+ *          and count. The JSON format has an object for each split with its
+ *          "time" and "count", and a "splits" object with the splits nested
+ *          within it. The splits may be exported in Python as follows:
+ *
+ * @code
+ *          openmoc.Timer.exportSplits('timing.json', openmoc.TIMER_JSON)
+ * @endcode
+ *
+ * @param filename the name of the file
+ * @param format the format of the file (TIMER_CSV or TIMER_JSON)
+ */
+void Timer::exportSplits(const char* filename, timerExportFormat format) {
+
+  std::map<std::string, timerSplit> splits = mergeSplits();
+
+  FILE* file = fopen(filename, "w");
+
+  if (file == NULL)
+    log_printf(ERROR, "Unable to open %s to export the Timer splits",
+               filename);
+
+  if (format == TIMER_JSON) {
+    timerNode root;
+    build_tree(splits, root);
 
-    curr_msg.resize(53, '.');
-    formatted_msg << curr_msg;
+    fprintf(file, "{\n");
+    write_json_tree(file, root, 1);
+    fprintf(file, "\n}\n");
+  }
+
+  else {
+    std::vector<std::string> paths;
+    timerNode root;
+
+    build_tree(splits, root);
+    list_paths(root, std::string(), paths);
 
-    log_printf(RESULT, "%s%1.4E sec", formatted_msg.str().c_str(), curr_split);
+    fprintf(file, "path,time,count\n");
+
+    for (size_t i=0; i < paths.size(); i++)
+      fprintf(file, "\"%s\",%.9E,%d\n", paths[i].c_str(),
+              splits[paths[i]].first, splits[paths[i]].second);
   }
+
+  fclose(file);
 }
 
 
 /**
- * @brief Clears the time split for this message and deletes the message's
- *        entry in the Timer's splits log.
- * @param msg the message tag for the split
+ * @brief Clears the time split for this message and the splits nested
+ *        within it, and deletes their entries in the Timer's splits log.
+ * @param path the path of the split
  */
-void Timer::clearSplit(const char* msg) {
+void Timer::clearSplit(const char* path) {
 
-  std::string msg_string = std::string(msg);
+  std::string prefix = std::string(path) + TIMER_PATH_SEPARATOR;
+  std::vector<std::map<std::string, timerSplit>*> logs;
+  std::map<std::string, timerSplit>::iterator iter;
 
-  if (_timer_splits.find(msg_string) == _timer_splits.end())
-    return;
-  else
-    _timer_splits.erase(msg_string);
+  #pragma omp critical (timer)
+  {
+    logs.push_back(&_exited_splits);
+
+    for (size_t i=0; i < _threads.size(); i++)
+      logs.push_back(&_threads[i]->_splits);
+
+    for (size_t i=0; i < logs.size(); i++) {
+      logs[i]->erase(std::string(path));
+
+      iter = logs[i]->lower_bound(prefix);
+      while (iter != logs[i]->end() &&
+             iter->first.compare(0, prefix.size(), prefix) == 0)
+        logs[i]->erase(iter++);
+    }
+  }
 }
 
 
@@ -134,5 +535,12 @@ void Timer::clearSplit(const char* msg) {
  * @brief Clears all times split messages from the Timer.
  */
 void Timer::clearSplits() {
-  _timer_splits.clear();
+
+  #pragma omp critical (timer)
+  {
+    _exited_splits.clear();
+
+    for (size_t i=0; i < _threads.size(); i++)
+      _threads[i]->_splits.clear();
+  }
 }
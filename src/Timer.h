@@ -11,6 +11,7 @@
 #ifdef __cplusplus
 #include <time.h>
 #include <omp.h>
+#include <stdio.h>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -22,26 +23,59 @@
 #endif
 
 
+/** The separator between the names of nested scopes in a split's path */
+#define TIMER_PATH_SEPARATOR '/'
+
+
+/**
+ * @enum timerExportFormat
+ * @brief The file formats to which the Timer's splits may be exported.
+ */
+enum timerExportFormat {
+
+  /** One row for each split with its path, time and count */
+  TIMER_CSV,
+
+  /** An object for each split nested within the object of its parent */
+  TIMER_JSON
+};
+
+
+/** A split's time (seconds) and the number of times it was recorded */
+typedef std::pair<double, int> timerSplit;
+
+/** The open scopes, running timers and splits of one thread */
+struct timerThread;
+
+
 /**
  * @class Timer Timer.h "src/Timer.cpp"
  * @brief The Timer class is for timing and profiling regions of code.
+ * @details Each thread keeps its own stack of open scopes and its own
+ *          splits, so that the Timer may be used by many threads at once
+ *          without locks. A scope opened while another is open on the same
+ *          thread is nested within it, and its split is recorded at the
+ *          path of the scope names joined by TIMER_PATH_SEPARATOR, such as
+ *          "Total time to converge the source/Transport sweep". The splits
+ *          of all threads are merged when they are reported, which should
+ *          be done outside of the parallel regions which are being timed.
  */
 class Timer {
 
 private:
 
-  /** A vector of floating point start times at each inclusive level
-   *  at which we are timing */
-  static std::vector<double> _start_times;
+  /** The state of each thread which has used the Timer */
+  static std::vector<timerThread*> _threads;
 
-  /** The time elapsed (seconds) for the current split */
-  float _elapsed_time;
+  /** The splits of the threads which have exited */
+  static std::map<std::string, timerSplit> _exited_splits;
 
-  /** Whether or not the Timer is running for the current split */
-  bool _running;
+  /** The paths of the merged splits in the order returned by
+   *  Timer::getSplitPath(...) */
+  static std::vector<std::string> _split_paths;
 
-  /** A vector of the times and messages for each split */
-  static std::map<std::string, double> _timer_splits;
+  static timerThread* getThread();
+  static std::map<std::string, timerSplit> mergeSplits();
 
   /**
    * @brief Assignment operator for static referencing of the Timer.
@@ -58,12 +92,9 @@ private:
 
 public:
   /**
-   * @brief Constructor sets the current split elapsed time to zero.
+   * @brief Constructor for a Timer, all of which share the same splits.
    */
-  Timer() {
-    _running = false;
-    _elapsed_time = 0;
-  }
+  Timer() { }
 
   /**
    * @brief Destructor
@@ -83,10 +114,46 @@ public:
   void stopTimer();
   void recordSplit(const char* msg);
   double getTime();
-  double getSplit(const char* msg);
+
+  void startScope(const char* name);
+  double stopScope();
+
+  double getSplit(const char* path);
+  int getSplitCount(const char* path);
+  int getNumSplits();
+  const char* getSplitPath(int index);
   void printSplits();
-  void clearSplit(const char* msg);
+  void exportSplits(const char* filename, timerExportFormat format);
+  void clearSplit(const char* path);
   void clearSplits();
+
+  friend struct timerThread;
+};
+
+
+/**
+ * @class TimerScope Timer.h "src/Timer.h"
+ * @brief A guard which opens a Timer scope when it is constructed and
+ *        closes it when it goes out of scope.
+ */
+class TimerScope {
+
+public:
+
+  /**
+   * @brief Opens a scope of the static Timer.
+   * @param name the name of the scope
+   */
+  TimerScope(const char* name) {
+    Timer::Get()->startScope(name);
+  }
+
+  /**
+   * @brief Closes the scope and records its split.
+   */
+  ~TimerScope() {
+    Timer::Get()->stopScope();
+  }
 };
 
 #endif /* TIMER_H_ */
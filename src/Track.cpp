@@ -369,10 +369,11 @@ bool Track::contains(Point* point) {
 
 
 /**
- * @brief Deletes each of this Track's segments.
+ * @brief Deletes each of this Track's segments and releases the memory
+ *        held by the segments container.
  */
 void Track::clearSegments() {
-  _segments.clear();
+  std::vector<segment>().swap(_segments);
 }
 
 
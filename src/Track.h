@@ -18,6 +18,8 @@
  * @struct segment
  * @brief A segment represents a line segment within a single flat source
  *        region along a track.
+ * @details Segments are only stored with each Track during ray tracing. The
+ *          TrackGenerator then moves them into flat arrays for the Solvers.
  */
 struct segment {
 
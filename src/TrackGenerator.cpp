@@ -16,6 +16,15 @@ TrackGenerator::TrackGenerator(Geometry* geometry, const int num_azim,
   _tot_num_tracks = 0;
   _tot_num_segments = 0;
   _num_segments = NULL;
+  _segment_offsets = NULL;
+  _segment_lengths = NULL;
+  _segment_FSR_ids = NULL;
+  _segment_material_uids = NULL;
+  _segment_cmfd_surfaces_fwd = NULL;
+  _segment_cmfd_surfaces_bwd = NULL;
+  _num_colors = NULL;
+  _color_offsets = NULL;
+  _color_tracks = NULL;
   _contains_tracks = false;
   _use_input_file = false;
   _tracks_filename = "";
@@ -40,6 +49,9 @@ TrackGenerator::~TrackGenerator() {
 
     delete [] _tracks;
   }
+
+  deleteSegments();
+  deleteTrackColors();
 }
 
 
@@ -130,6 +142,92 @@ int* TrackGenerator::getNumSegmentsArray() {
 }
 
 
+/**
+ * @brief Return an array of the offsets of each Track's first segment into
+ *        the flat segment arrays.
+ * @details The segments for the Track with UID i are stored in the flat
+ *          segment arrays from offset i up to (but not including) offset
+ *          i+1. The array has one more entry than the number of Tracks.
+ * @return array with the segment offsets for each Track
+ */
+int* TrackGenerator::getSegmentOffsets() {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the segment offsets since Tracks "
+               "have not yet been generated.");
+
+  return _segment_offsets;
+}
+
+
+/**
+ * @brief Return the array of the lengths (cm) of all segments.
+ * @return array of segment lengths
+ */
+FP_PRECISION* TrackGenerator::getSegmentLengths() {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the segment lengths since Tracks "
+               "have not yet been generated.");
+
+  return _segment_lengths;
+}
+
+
+/**
+ * @brief Return the array of the FSR IDs of all segments.
+ * @return array of segment FSR IDs
+ */
+int* TrackGenerator::getSegmentFSRIds() {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the segment FSR IDs since Tracks "
+               "have not yet been generated.");
+
+  return _segment_FSR_ids;
+}
+
+
+/**
+ * @brief Return the array of the Material UIDs of all segments.
+ * @return array of segment Material UIDs
+ */
+int* TrackGenerator::getSegmentMaterialUids() {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the segment Material UIDs since "
+               "Tracks have not yet been generated.");
+
+  return _segment_material_uids;
+}
+
+
+/**
+ * @brief Return the array of the CMFD Mesh surfaces crossed by the end
+ *        point of each segment.
+ * @details The array is NULL if the Geometry does not contain a Cmfd object.
+ * @return array of segment forward CMFD Mesh surfaces
+ */
+int* TrackGenerator::getSegmentCmfdSurfacesFwd() {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the segment CMFD surfaces since "
+               "Tracks have not yet been generated.");
+
+  return _segment_cmfd_surfaces_fwd;
+}
+
+
+/**
+ * @brief Return the array of the CMFD Mesh surfaces crossed by the start
+ *        point of each segment.
+ * @details The array is NULL if the Geometry does not contain a Cmfd object.
+ * @return array of segment backward CMFD Mesh surfaces
+ */
+int* TrackGenerator::getSegmentCmfdSurfacesBwd() {
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the segment CMFD surfaces since "
+               "Tracks have not yet been generated.");
+
+  return _segment_cmfd_surfaces_bwd;
+}
+
+
 /**
  * @brief Returns a 2D jagged array of the Tracks.
  * @details The first index into the array is the azimuthal angle and the
@@ -158,6 +256,69 @@ FP_PRECISION* TrackGenerator::getAzimWeights() {
 }
 
 
+/**
+ * @brief Return the total number of Track colors for both azimuthal angle
+ *        halfspaces.
+ * @return the total number of Track colors
+ */
+int TrackGenerator::getNumColors() {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the number of Track colors since "
+               "Tracks have not yet been generated.");
+
+  return _num_colors[0] + _num_colors[1];
+}
+
+
+/**
+ * @brief Return an array of the number of Track colors for each azimuthal
+ *        angle halfspace.
+ * @details The colors for the first halfspace are numbered from zero and
+ *          the colors for the second halfspace follow those of the first.
+ * @return array with the number of Track colors per halfspace
+ */
+int* TrackGenerator::getNumColorsArray() {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the array of the number of Track "
+               "colors since Tracks have not yet been generated.");
+
+  return _num_colors;
+}
+
+
+/**
+ * @brief Return an array of the offsets into the colored Track array for
+ *        each Track color.
+ * @details The UIDs of the Tracks with color c are stored in the colored
+ *          Track array from offset c up to (but not including) offset c+1.
+ * @return array with the offsets for each color
+ */
+int* TrackGenerator::getColorOffsets() {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the Track color offsets since "
+               "Tracks have not yet been generated.");
+
+  return _color_offsets;
+}
+
+
+/**
+ * @brief Return an array of the Track UIDs sorted by Track color.
+ * @return array of the Track UIDs sorted by color
+ */
+int* TrackGenerator::getColorTracks() {
+
+  if (!_contains_tracks)
+    log_printf(ERROR, "Unable to return the colored Tracks since Tracks "
+               "have not yet been generated.");
+
+  return _color_tracks;
+}
+
+
 /**
  * @brief Returns whether or not the TrackGenerator contains Track that are
  *        for its current number of azimuthal angles, track spacing and
@@ -233,10 +394,9 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int num_segments) {
                "but an array of length %d was input",
                getNumSegments(), 5*getNumSegments(), num_segments);
 
-  segment* curr_segment = NULL;
   double x0, x1, y0, y1;
   double phi;
-  segment* segments;
+  int uid;
 
   int counter = 0;
 
@@ -248,19 +408,17 @@ void TrackGenerator::retrieveSegmentCoords(double* coords, int num_segments) {
       x0 = _tracks[i][j].getStart()->getX();
       y0 = _tracks[i][j].getStart()->getY();
       phi = _tracks[i][j].getPhi();
+      uid = _tracks[i][j].getUid();
 
-      segments = _tracks[i][j].getSegments();
-
-      for (int s=0; s < _tracks[i][j].getNumSegments(); s++) {
-        curr_segment = &segments[s];
+      for (int s=_segment_offsets[uid]; s < _segment_offsets[uid+1]; s++) {
 
-        coords[counter] = curr_segment->_region_id;
+        coords[counter] = _segment_FSR_ids[s];
 
         coords[counter+1] = x0;
         coords[counter+2] = y0;
 
-        x1 = x0 + cos(phi) * curr_segment->_length;
-        y1 = y0 + sin(phi) * curr_segment->_length;
+        x1 = x0 + cos(phi) * _segment_lengths[s];
+        y1 = y0 + sin(phi) * _segment_lengths[s];
 
         coords[counter+3] = x1;
         coords[counter+4] = y1;
@@ -344,6 +502,8 @@ void TrackGenerator::generateTracks() {
     log_printf(ERROR, "Unable to generate Tracks since no Geometry "
                "has been set for the TrackGenerator");
 
+  TimerScope scope("Track generation");
+
   /* Deletes Tracks arrays if Tracks have been generated */
   if (_contains_tracks) {
     delete [] _num_tracks;
@@ -358,6 +518,8 @@ void TrackGenerator::generateTracks() {
     delete [] _tracks;
   }
 
+  deleteSegments();
+  deleteTrackColors();
   initializeTrackFileDirectory();
 
   /* If not Tracks input file exists, generate Tracks */
@@ -390,6 +552,8 @@ void TrackGenerator::generateTracks() {
       initializeTracks();
       recalibrateTracksToOrigin();
       segmentize();
+      flattenSegments();
+      colorTracks();
       dumpTracksToFile();
     }
     catch (std::exception &e) {
@@ -955,11 +1119,18 @@ void TrackGenerator::initializeBoundaryConditions() {
 
 /**
  * @brief Generate segments for each Track across the Geometry.
+ * @details The Tracks are segmented in parallel by OpenMP threads. The FSRs
+ *          found by the threads are then renumbered in the order in which
+ *          the Tracks first cross them, which is the order in which they
+ *          would be found if the Tracks were segmented one after another,
+ *          so that the FSR IDs do not depend on the number of threads.
  */
 void TrackGenerator::segmentize() {
 
   log_printf(NORMAL, "Ray tracing for track segmentation...");
 
+  TimerScope scope("Ray tracing");
+
   Track* track;
 
   if (_num_segments != NULL)
@@ -969,13 +1140,53 @@ void TrackGenerator::segmentize() {
    * Tracks were not read in from an input file */
   if (!_use_input_file) {
 
-    /* Loop over all Tracks */
+    /* The Tracks in the order of the serial ray tracing */
+    std::vector<Track*> tracks;
+
     for (int i=0; i < _num_azim; i++) {
-      for (int j=0; j < _num_tracks[i]; j++){
-        track = &_tracks[i][j];
-        log_printf(DEBUG, "Segmenting Track %d/%d with i = %d, j = %d",
-        track->getUid(), _tot_num_tracks, i, j);
-        _geometry->segmentize(track);
+      for (int j=0; j < _num_tracks[i]; j++)
+        tracks.push_back(&_tracks[i][j]);
+    }
+
+    /* FSRs which were found before this ray tracing keep their IDs */
+    int num_old_FSRs = _geometry->getNumFSRs();
+
+    /* Give each thread a private table of the FSRs it finds */
+    _geometry->initializeThreadFSRTables(omp_get_max_threads());
+
+    /* Loop over all Tracks */
+    #pragma omp parallel for schedule(dynamic)
+    for (int t=0; t < _tot_num_tracks; t++) {
+      log_printf(DEBUG, "Segmenting Track %d/%d", tracks[t]->getUid(),
+                 _tot_num_tracks);
+      _geometry->segmentize(tracks[t]);
+    }
+
+    _geometry->clearThreadFSRTables();
+
+    /* Number the new FSRs in the order in which the Tracks cross them */
+    std::vector<int> fsr_ids(_geometry->getNumFSRs(), -1);
+    int next_fsr_id = num_old_FSRs;
+
+    for (int r=0; r < num_old_FSRs; r++)
+      fsr_ids[r] = r;
+
+    for (int t=0; t < _tot_num_tracks; t++) {
+      for (int s=0; s < tracks[t]->getNumSegments(); s++) {
+        int fsr_id = tracks[t]->getSegment(s)->_region_id;
+
+        if (fsr_ids[fsr_id] == -1)
+          fsr_ids[fsr_id] = next_fsr_id++;
+      }
+    }
+
+    _geometry->renumberFSRs(fsr_ids);
+
+    #pragma omp parallel for
+    for (int t=0; t < _tot_num_tracks; t++) {
+      for (int s=0; s < tracks[t]->getNumSegments(); s++) {
+        segment* curr_segment = tracks[t]->getSegment(s);
+        curr_segment->_region_id = fsr_ids[curr_segment->_region_id];
       }
     }
 
@@ -998,6 +1209,262 @@ void TrackGenerator::segmentize() {
 }
 
 
+/**
+ * @brief Moves the segments of all Tracks into contiguous arrays.
+ * @details The segment lengths, FSR IDs, Material UIDs and CMFD Mesh
+ *          surfaces (if needed) are each stored in a separate array aligned
+ *          to a cache line, with the segments for each Track stored
+ *          contiguously in order of Track UID. The segments are then
+ *          cleared from each Track to release their memory.
+ */
+void TrackGenerator::flattenSegments() {
+
+  deleteSegments();
+
+  Cmfd* cmfd = _geometry->getCmfd();
+  Track* track;
+  segment* curr_segment;
+  int uid, offset;
+
+  /* Compute the offset to each Track's segments */
+  _segment_offsets = new int[_tot_num_tracks+1];
+  _segment_offsets[0] = 0;
+
+  for (int i=0; i < _num_azim; i++) {
+    for (int j=0; j < _num_tracks[i]; j++) {
+      uid = _tracks[i][j].getUid();
+      _segment_offsets[uid+1] = _num_segments[uid];
+    }
+  }
+
+  for (uid=0; uid < _tot_num_tracks; uid++)
+    _segment_offsets[uid+1] += _segment_offsets[uid];
+
+  /* Allocate cache line aligned arrays for the segment data */
+  int size = _tot_num_segments;
+  _segment_lengths = (FP_PRECISION*)MM_MALLOC(size * sizeof(FP_PRECISION),
+                                              SEGMENT_ALIGNMENT);
+  _segment_FSR_ids = (int*)MM_MALLOC(size * sizeof(int), SEGMENT_ALIGNMENT);
+  _segment_material_uids = (int*)MM_MALLOC(size * sizeof(int),
+                                           SEGMENT_ALIGNMENT);
+
+  if (cmfd != NULL) {
+    _segment_cmfd_surfaces_fwd = (int*)MM_MALLOC(size * sizeof(int),
+                                                 SEGMENT_ALIGNMENT);
+    _segment_cmfd_surfaces_bwd = (int*)MM_MALLOC(size * sizeof(int),
+                                                 SEGMENT_ALIGNMENT);
+  }
+
+  if (_segment_lengths == NULL || _segment_FSR_ids == NULL ||
+      _segment_material_uids == NULL || (cmfd != NULL &&
+      (_segment_cmfd_surfaces_fwd == NULL ||
+       _segment_cmfd_surfaces_bwd == NULL)))
+    log_printf(ERROR, "Unable to allocate memory for %d segments",
+               _tot_num_segments);
+
+  /* Copy each Track's segments into the flat arrays */
+  #pragma omp parallel for private(track, curr_segment, uid, offset)
+  for (int i=0; i < _num_azim; i++) {
+    for (int j=0; j < _num_tracks[i]; j++) {
+
+      track = &_tracks[i][j];
+      uid = track->getUid();
+      offset = _segment_offsets[uid];
+
+      for (int s=0; s < track->getNumSegments(); s++) {
+        curr_segment = track->getSegment(s);
+        _segment_lengths[offset+s] = curr_segment->_length;
+        _segment_FSR_ids[offset+s] = curr_segment->_region_id;
+        _segment_material_uids[offset+s] = curr_segment->_material->getUid();
+
+        if (cmfd != NULL) {
+          _segment_cmfd_surfaces_fwd[offset+s] = 
+              curr_segment->_cmfd_surface_fwd;
+          _segment_cmfd_surfaces_bwd[offset+s] = 
+              curr_segment->_cmfd_surface_bwd;
+        }
+      }
+
+      /* Release the memory for this Track's segments */
+      track->clearSegments();
+    }
+  }
+
+  /* Report the memory for the flat and per-Track segment storage */
+  int num_arrays = (cmfd != NULL) ? 4 : 2;
+  double flat_bytes = double(_tot_num_segments) *
+                      (sizeof(FP_PRECISION) + num_arrays * sizeof(int)) +
+                      double(_tot_num_tracks + 1) * sizeof(int);
+  double track_bytes = double(_tot_num_segments) * sizeof(segment);
+
+  log_printf(INFO, "Flat segment storage uses %.2f MB (per-Track segments "
+             "used %.2f MB)", flat_bytes / (1024. * 1024.), 
+             track_bytes / (1024. * 1024.));
+
+  return;
+}
+
+
+/**
+ * @brief Deletes the flat segment arrays if they have been allocated.
+ */
+void TrackGenerator::deleteSegments() {
+
+  if (_segment_offsets != NULL)
+    delete [] _segment_offsets;
+
+  if (_segment_lengths != NULL)
+    MM_FREE(_segment_lengths);
+
+  if (_segment_FSR_ids != NULL)
+    MM_FREE(_segment_FSR_ids);
+
+  if (_segment_material_uids != NULL)
+    MM_FREE(_segment_material_uids);
+
+  if (_segment_cmfd_surfaces_fwd != NULL)
+    MM_FREE(_segment_cmfd_surfaces_fwd);
+
+  if (_segment_cmfd_surfaces_bwd != NULL)
+    MM_FREE(_segment_cmfd_surfaces_bwd);
+
+  _segment_offsets = NULL;
+  _segment_lengths = NULL;
+  _segment_FSR_ids = NULL;
+  _segment_material_uids = NULL;
+  _segment_cmfd_surfaces_fwd = NULL;
+  _segment_cmfd_surfaces_bwd = NULL;
+}
+
+
+/**
+ * @brief Partitions the Tracks in each azimuthal angle halfspace into colors
+ *        such that no two Tracks of the same color cross the same FSR.
+ * @details Tracks are colored greedily in UID order with the smallest color
+ *          not yet used by a Track crossing any of the same FSRs. Since
+ *          neighboring parallel Tracks share FSRs while Tracks far apart do
+ *          not, each color forms spatially separated stripes of Tracks for
+ *          each azimuthal angle. The Tracks of a single color may be swept
+ *          concurrently without atomic updates to the FSR scalar fluxes.
+ */
+void TrackGenerator::colorTracks() {
+
+  log_printf(NORMAL, "Coloring tracks for conflict-free transport sweeps...");
+
+  deleteTrackColors();
+
+  int num_FSRs = _geometry->getNumFSRs();
+  int* track_colors = new int[_tot_num_tracks];
+  _num_colors = new int[2];
+
+  /* The colors used by the Tracks crossing each FSR */
+  std::vector< std::vector<int> > FSR_colors;
+
+  /* The UID of the last Track for which each color was unavailable */
+  std::vector<int> forbidden;
+
+  int uid, color, region_id;
+
+  /* Loop over azimuthal angle halfspaces */
+  for (int h=0; h < 2; h++) {
+
+    _num_colors[h] = 0;
+    FSR_colors.clear();
+    FSR_colors.resize(num_FSRs);
+    forbidden.clear();
+
+    for (int i=h*_num_azim/2; i < (h+1)*_num_azim/2; i++) {
+      for (int j=0; j < _num_tracks[i]; j++) {
+
+        uid = _tracks[i][j].getUid();
+
+        /* Mark the colors of all Tracks crossing this Track's FSRs */
+        for (int s=_segment_offsets[uid]; s < _segment_offsets[uid+1]; s++) {
+          region_id = _segment_FSR_ids[s];
+          for (size_t c=0; c < FSR_colors[region_id].size(); c++)
+            forbidden[FSR_colors[region_id][c]] = uid;
+        }
+
+        /* Find the smallest available color for this Track */
+        color = 0;
+        while (color < (int) forbidden.size() && forbidden[color] == uid)
+          color++;
+
+        if (color == (int) forbidden.size())
+          forbidden.push_back(-1);
+
+        track_colors[uid] = color;
+        _num_colors[h] = std::max(_num_colors[h], color+1);
+
+        /* Add this Track's color to each of the FSRs it crosses */
+        for (int s=_segment_offsets[uid]; s < _segment_offsets[uid+1]; s++) {
+          region_id = _segment_FSR_ids[s];
+          if (FSR_colors[region_id].empty() ||
+              FSR_colors[region_id].back() != color)
+            FSR_colors[region_id].push_back(color);
+        }
+      }
+    }
+
+    /* Number the colors for the second halfspace after the first */
+    if (h == 1) {
+      for (uid=_tot_num_tracks/2; uid < _tot_num_tracks; uid++)
+        track_colors[uid] += _num_colors[0];
+    }
+  }
+
+  /* Sort the Track UIDs by color */
+  int num_colors = _num_colors[0] + _num_colors[1];
+  _color_offsets = new int[num_colors+1];
+  _color_tracks = new int[_tot_num_tracks];
+
+  for (int c=0; c <= num_colors; c++)
+    _color_offsets[c] = 0;
+
+  for (uid=0; uid < _tot_num_tracks; uid++)
+    _color_offsets[track_colors[uid]+1]++;
+
+  for (int c=0; c < num_colors; c++)
+    _color_offsets[c+1] += _color_offsets[c];
+
+  int* counters = new int[num_colors];
+  for (int c=0; c < num_colors; c++)
+    counters[c] = _color_offsets[c];
+
+  for (uid=0; uid < _tot_num_tracks; uid++)
+    _color_tracks[counters[track_colors[uid]]++] = uid;
+
+  delete [] counters;
+  delete [] track_colors;
+
+  log_printf(INFO, "Colored %d Tracks with %d colors (%d and %d per "
+             "halfspace)", _tot_num_tracks, num_colors, _num_colors[0],
+             _num_colors[1]);
+
+  return;
+}
+
+
+/**
+ * @brief Deletes the Track coloring arrays if they have been allocated.
+ */
+void TrackGenerator::deleteTrackColors() {
+
+  if (_num_colors != NULL)
+    delete [] _num_colors;
+
+  if (_color_offsets != NULL)
+    delete [] _color_offsets;
+
+  if (_color_tracks != NULL)
+    delete [] _color_tracks;
+
+  _num_colors = NULL;
+  _color_offsets = NULL;
+  _color_tracks = NULL;
+}
+
+
 /**
  * @brief Writes all Track and segment data to a "*.tracks" binary file.
  * @details Storing Tracks in a binary file saves time by eliminating ray
@@ -1007,6 +1474,8 @@ void TrackGenerator::dumpTracksToFile() {
 
   log_printf(NORMAL, "Dumping tracks to file...");
 
+  TimerScope scope("Write Track file");
+
   if (!_contains_tracks)
     log_printf(ERROR, "Unable to dump Tracks to a file since no Tracks have "
       "been generated for %d azimuthal angles and %f track spacing",
@@ -1019,8 +1488,12 @@ void TrackGenerator::dumpTracksToFile() {
    * check whether or not ray tracing has been performed for this Geometry */
   std::string geometry_to_string = _geometry->toString();
   int string_length = geometry_to_string.length() + 1;
+  int version = TRACK_FILE_VERSION;
+  int key_length = _geometry->getFSRKeyLength();
 
   /* Write geometry metadata to the Track file */
+  fwrite(&version, sizeof(int), 1, out);
+  fwrite(&key_length, sizeof(int), 1, out);
   fwrite(&string_length, sizeof(int), 1, out);
   fwrite(geometry_to_string.c_str(), sizeof(char)*string_length, 1, out);
 
@@ -1043,16 +1516,23 @@ void TrackGenerator::dumpTracksToFile() {
   double phi;
   int azim_angle_index;
   int num_segments;
-  std::vector<segment*> _segments;
+  int uid;
   Cmfd* cmfd = _geometry->getCmfd();
 
-  segment* curr_segment;
   double length;
   int material_id;
   int region_id;
   int cmfd_surface_fwd;
   int cmfd_surface_bwd;
 
+  /* Map the Material UIDs stored with each segment to Material IDs */
+  std::map<int, Material*> materials = _geometry->getMaterials();
+  std::map<int, Material*>::iterator mat_iter;
+  int* material_ids = new int[materials.size()];
+
+  for (mat_iter = materials.begin(); mat_iter != materials.end(); ++mat_iter)
+    material_ids[mat_iter->second->getUid()] = mat_iter->first;
+
   /* Loop over all Tracks */
   for (int i=0; i < _num_azim; i++) {
     for (int j=0; j < _num_tracks[i]; j++) {
@@ -1065,7 +1545,8 @@ void TrackGenerator::dumpTracksToFile() {
       y1 = curr_track->getEnd()->getY();
       phi = curr_track->getPhi();
       azim_angle_index = curr_track->getAzimAngleIndex();
-      num_segments = curr_track->getNumSegments();
+      uid = curr_track->getUid();
+      num_segments = _num_segments[uid];
 
       /* Write data for this Track to the Track file */
       fwrite(&x0, sizeof(double), 1, out);
@@ -1077,13 +1558,12 @@ void TrackGenerator::dumpTracksToFile() {
       fwrite(&num_segments, sizeof(int), 1, out);
 
       /* Loop over all segments for this Track */
-      for (int s=0; s < num_segments; s++) {
+      for (int s=_segment_offsets[uid]; s < _segment_offsets[uid+1]; s++) {
 
         /* Get data for this segment */
-        curr_segment = curr_track->getSegment(s);
-        length = curr_segment->_length;
-        material_id = curr_segment->_material->getId();
-        region_id = curr_segment->_region_id;
+        length = _segment_lengths[s];
+        material_id = material_ids[_segment_material_uids[s]];
+        region_id = _segment_FSR_ids[s];
 
         /* Write data for this segment to the Track file */
         fwrite(&length, sizeof(double), 1, out);
@@ -1092,8 +1572,8 @@ void TrackGenerator::dumpTracksToFile() {
 
         /* Write CMFD-related data for the Track if needed */
         if (cmfd != NULL){
-          cmfd_surface_fwd = curr_segment->_cmfd_surface_fwd;
-          cmfd_surface_bwd = curr_segment->_cmfd_surface_bwd;
+          cmfd_surface_fwd = _segment_cmfd_surfaces_fwd[s];
+          cmfd_surface_bwd = _segment_cmfd_surfaces_bwd[s];
           fwrite(&cmfd_surface_fwd, sizeof(int), 1, out);
           fwrite(&cmfd_surface_bwd, sizeof(int), 1, out);
         }
@@ -1101,41 +1581,25 @@ void TrackGenerator::dumpTracksToFile() {
     }      
   }
 
-  /* Get FSR vector maps */
-  std::map<std::size_t, fsr_data> FSR_keys_map = _geometry->getFSRKeysMap();
-  std::map<std::size_t, fsr_data>::iterator iter;
-  std::vector<std::size_t> FSRs_to_keys = _geometry->getFSRsToKeys();
-  std::vector<int> FSRs_to_material_IDs = _geometry->getFSRsToMaterialIDs();
-  std::size_t fsr_key;
-  int fsr_id;
-  int fsr_counter = 0;
-  double x, y;
+  delete [] material_ids;
 
   /* Write number of FSRs */
   int num_FSRs = _geometry->getNumFSRs();
   fwrite(&num_FSRs, sizeof(int), 1, out);
 
-  /* Write FSR vector maps to file */
-  for (iter = FSR_keys_map.begin(); iter != FSR_keys_map.end(); ++iter){
+  /* Write the key, characteristic point and Material ID of each FSR */
+  std::vector<int> FSRs_to_material_IDs = _geometry->getFSRsToMaterialIDs();
+  fsr_data* fsr;
+  double x, y;
 
-    /* Write data to file from FSR_keys_map */
-    fsr_key = iter->first;
-    fsr_id = iter->second._fsr_id;
-    x = iter->second._point->getX();
-    y = iter->second._point->getY();
-    fwrite(&fsr_key, sizeof(std::size_t), 1, out);
-    fwrite(&fsr_id, sizeof(int), 1, out);
+  for (int r=0; r < num_FSRs; r++) {
+    fsr = _geometry->getFSRData(r);
+    x = fsr->_point.getX();
+    y = fsr->_point.getY();
+    fwrite(_geometry->getFSRKeyPath(r), sizeof(int), key_length, out);
     fwrite(&x, sizeof(double), 1, out);
     fwrite(&y, sizeof(double), 1, out);
-    
-    /* Write data to file from FSRs_to_material_IDs */
-    fwrite(&(FSRs_to_material_IDs.at(fsr_counter)), sizeof(int), 1, out);
-
-    /* Write data to file from FSRs_to_keys */
-    fwrite(&(FSRs_to_keys.at(fsr_counter)), sizeof(std::size_t), 1, out);
-
-    /* Increment FSR ID counter */
-    fsr_counter++;
+    fwrite(&(FSRs_to_material_IDs.at(r)), sizeof(int), 1, out);
   }
 
   /* Write cmfd_fsrs vector of vectors to file */
@@ -1156,6 +1620,12 @@ void TrackGenerator::dumpTracksToFile() {
         fwrite(&(*iter), sizeof(int), 1, out);
     }        
   }   
+
+  /* Write the Track coloring to file */
+  int num_colors = _num_colors[0] + _num_colors[1];
+  fwrite(_num_colors, sizeof(int), 2, out);
+  fwrite(_color_offsets, sizeof(int), num_colors+1, out);
+  fwrite(_color_tracks, sizeof(int), _tot_num_tracks, out);
    
   /* Close the Track file */
   fclose(out);
@@ -1177,6 +1647,8 @@ void TrackGenerator::dumpTracksToFile() {
  */
 bool TrackGenerator::readTracksFromFile() {
 
+  TimerScope scope("Read Track file");
+
   /* Deletes Tracks arrays if tracks have been generated */
   if (_contains_tracks) {
     delete [] _num_tracks;
@@ -1191,11 +1663,29 @@ bool TrackGenerator::readTracksFromFile() {
     delete [] _tracks;
   }
 
+  deleteSegments();
+  deleteTrackColors();
+
   int ret;
   FILE* in;
   in = fopen(_tracks_filename.c_str(), "r");
 
   int string_length;
+  int version;
+  int key_length;
+
+  /* Skip Track files written with a different layout or FSR key length */
+  ret = fread(&version, sizeof(int), 1, in);
+  if (ret != 1 || version != TRACK_FILE_VERSION) {
+    fclose(in);
+    return false;
+  }
+
+  ret = fread(&key_length, sizeof(int), 1, in);
+  if (ret != 1 || key_length != _geometry->getFSRKeyLength()) {
+    fclose(in);
+    return false;
+  }
 
   /* Import Geometry metadata from the Track file */
   ret = fread(&string_length, sizeof(int), 1, in);
@@ -1247,6 +1737,7 @@ bool TrackGenerator::readTracksFromFile() {
 
   int cmfd_surface_fwd;
   int cmfd_surface_bwd;
+  segment curr_segment;
 
   /* Calculate the total number of Tracks */
   for (int i=0; i < _num_azim; i++)
@@ -1275,7 +1766,7 @@ bool TrackGenerator::readTracksFromFile() {
       ret = fread(&num_segments, sizeof(int), 1, in);
 
       _tot_num_segments += num_segments;
-      _num_segments[uid] += num_segments;
+      _num_segments[uid] = num_segments;
 
       /* Initialize a Track with this data */
       curr_track = &_tracks[i][j];
@@ -1292,69 +1783,45 @@ bool TrackGenerator::readTracksFromFile() {
         ret = fread(&region_id, sizeof(int), 1, in);
 
         /* Initialize segment with the data */
-        segment* curr_segment = new segment;
-        curr_segment->_length = length;
-        curr_segment->_material = _geometry->getMaterial(material_id);
-        curr_segment->_region_id = region_id;
+        curr_segment._length = length;
+        curr_segment._material = _geometry->getMaterial(material_id);
+        curr_segment._region_id = region_id;
 
         /* Import CMFD-related data if needed */
         if (cmfd != NULL){
           ret = fread(&cmfd_surface_fwd, sizeof(int), 1, in);
           ret = fread(&cmfd_surface_bwd, sizeof(int), 1, in);
-          curr_segment->_cmfd_surface_fwd = cmfd_surface_fwd;
-          curr_segment->_cmfd_surface_bwd = cmfd_surface_bwd;
+          curr_segment._cmfd_surface_fwd = cmfd_surface_fwd;
+          curr_segment._cmfd_surface_bwd = cmfd_surface_bwd;
         }
 
         /* Add this segment to the Track */
-        curr_track->addSegment(curr_segment);
+        curr_track->addSegment(&curr_segment);
       }
 
       uid++;
     }
   }
 
-  /* Create FSR vector maps */
-  std::map<std::size_t, fsr_data> FSR_keys_map;
-  std::vector<int> FSRs_to_material_IDs;
-  std::vector<std::size_t> FSRs_to_keys;
+  /* Move the segments into the flat segment arrays */
+  flattenSegments();
+
+  /* Import the key, characteristic point and Material ID of each FSR */
   int num_FSRs;
-  std::size_t fsr_key;
-  int fsr_key_id;
+  std::vector<int> key(key_length);
   double x, y;
 
-  /* Get number of FSRs */
   ret = fread(&num_FSRs, sizeof(int), 1, in);
-  _geometry->setNumFSRs(num_FSRs);
-
-  /* Read FSR vector maps from file */
-  for (int fsr_id=0; fsr_id < num_FSRs; fsr_id++){
+  _geometry->clearFSRs();
 
-    /* Read data from file for FSR_keys_map */
-    ret = fread(&fsr_key, sizeof(std::size_t), 1, in);
-    ret = fread(&fsr_key_id, sizeof(int), 1, in);
+  for (int r=0; r < num_FSRs; r++) {
+    ret = fread(&key[0], sizeof(int), key_length, in);
     ret = fread(&x, sizeof(double), 1, in);
     ret = fread(&y, sizeof(double), 1, in);
-    fsr_data* fsr = new fsr_data;
-    fsr->_fsr_id = fsr_key_id;
-    Point* point = new Point();
-    point->setCoords(x,y);
-    fsr->_point = point;
-    FSR_keys_map[fsr_key] = *fsr;
-
-    /* Read data from file for FSR_to_materials_IDs */
     ret = fread(&material_id, sizeof(int), 1, in);
-    FSRs_to_material_IDs.push_back(material_id);
-
-    /* Read data from file for FSR_to_keys */
-    ret = fread(&fsr_key, sizeof(std::size_t), 1, in);
-    FSRs_to_keys.push_back(fsr_key);
+    _geometry->addFSR(&key[0], x, y, material_id);
   }
 
-  /* Set FSR vector maps */
-  _geometry->setFSRKeysMap(FSR_keys_map);
-  _geometry->setFSRsToMaterialIDs(FSRs_to_material_IDs);
-  _geometry->setFSRsToKeys(FSRs_to_keys);
-   
   /* Read cmfd cell_fsrs vector of vectors from file */
   if (cmfd != NULL){
     std::vector< std::vector<int> > cell_fsrs;
@@ -1382,6 +1849,21 @@ bool TrackGenerator::readTracksFromFile() {
   if (ret)
     _contains_tracks = true;
 
+  /* Read the Track coloring from file if it was stored with the Tracks */
+  _num_colors = new int[2];
+
+  if (fread(_num_colors, sizeof(int), 2, in) == 2) {
+    int num_colors = _num_colors[0] + _num_colors[1];
+    _color_offsets = new int[num_colors+1];
+    _color_tracks = new int[_tot_num_tracks];
+    ret = fread(_color_offsets, sizeof(int), num_colors+1, in);
+    ret = fread(_color_tracks, sizeof(int), _tot_num_tracks, in);
+  }
+
+  /* Otherwise color the Tracks imported from an older Track file */
+  else
+    colorTracks();
+
   /* Close the Track file */
   fclose(in);
 
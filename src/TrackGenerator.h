@@ -20,6 +20,13 @@
 #include "Geometry.h"
 #endif
 
+/** The memory alignment (bytes) for the flat segment arrays */
+#define SEGMENT_ALIGNMENT 64
+
+/** The version of the Track file layout, which is written at the start of
+ *  each file so that files with an older layout are not imported */
+#define TRACK_FILE_VERSION 3
+
 
 /**
  * @class TrackGenerator TrackGenerator.h "src/TrackGenerator.h"
@@ -50,6 +57,25 @@ private:
   /** The total number of segments for all Tracks */
   int _tot_num_segments;
 
+  /** The offset of each Track's first segment into the flat segment arrays,
+   *  indexed by Track UID (with one extra entry for the total) */
+  int* _segment_offsets;
+
+  /** The lengths (cm) of all segments stored contiguously by Track UID */
+  FP_PRECISION* _segment_lengths;
+
+  /** The FSR IDs of all segments stored contiguously by Track UID */
+  int* _segment_FSR_ids;
+
+  /** The Material UIDs of all segments stored contiguously by Track UID */
+  int* _segment_material_uids;
+
+  /** The CMFD Mesh surfaces crossed by the end point of each segment */
+  int* _segment_cmfd_surfaces_fwd;
+
+  /** The CMFD Mesh surfaces crossed by the start point of each segment */
+  int* _segment_cmfd_surfaces_bwd;
+
   /** An integer array of the number of Tracks starting on the x-axis for each
    *  azimuthal angle */
   int* _num_x;
@@ -64,6 +90,15 @@ private:
   /** A 2D ragged array of Tracks */
   Track** _tracks;
 
+  /** The number of Track colors for each azimuthal angle halfspace */
+  int* _num_colors;
+
+  /** The offsets into the colored Track array for each color */
+  int* _color_offsets;
+
+  /** An array of Track UIDs sorted by color */
+  int* _color_tracks;
+
   /** Pointer to the Geometry */
   Geometry* _geometry;
 
@@ -84,6 +119,10 @@ private:
   void recalibrateTracksToOrigin();
   void initializeBoundaryConditions();
   void segmentize();
+  void flattenSegments();
+  void deleteSegments();
+  void colorTracks();
+  void deleteTrackColors();
   void dumpTracksToFile();
   bool readTracksFromFile();
 
@@ -99,8 +138,18 @@ public:
   int* getNumTracksArray();
   int getNumSegments();
   int* getNumSegmentsArray();
+  int* getSegmentOffsets();
+  FP_PRECISION* getSegmentLengths();
+  int* getSegmentFSRIds();
+  int* getSegmentMaterialUids();
+  int* getSegmentCmfdSurfacesFwd();
+  int* getSegmentCmfdSurfacesBwd();
   Track** getTracks();
   FP_PRECISION* getAzimWeights();
+  int getNumColors();
+  int* getNumColorsArray();
+  int* getColorOffsets();
+  int* getColorTracks();
 
   /* Set parameters */
   void setNumAzim(int num_azim);
@@ -303,7 +303,7 @@ void Universe::setFissionability(bool fissionable) {
  * @return a pointer the Cell where the LocalCoords is located
  */
 Cell* Universe::findCell(LocalCoords* coords,
-                         std::map<int, Universe*> universes) {
+                         std::map<int, Universe*>& universes) {
 
   Cell* return_cell = NULL;
   std::map<int, Cell*>::iterator iter;
@@ -776,7 +776,7 @@ bool Lattice::withinBounds(Point* point) {
  * @return a pointer to the Cell this LocalCoord is in or NULL
  */
 Cell* Lattice::findCell(LocalCoords* coords,
-                        std::map<int, Universe*> universes) {
+                        std::map<int, Universe*>& universes) {
 
   /* Set the LocalCoord to be a LAT type at this level */
   coords->setType(LAT);
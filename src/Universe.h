@@ -104,7 +104,7 @@ public:
 
   void setFissionability(bool fissionable);
 
-  Cell* findCell(LocalCoords* coords, std::map<int, Universe*> universes);
+  Cell* findCell(LocalCoords* coords, std::map<int, Universe*>& universes);
   double minSurfaceDist(Point* point, double angle);
   void subdivideCells();
   std::string toString();
@@ -168,7 +168,7 @@ public:
   void setUniversePointer(Universe* universe);
 
   bool withinBounds(Point* point);
-  Cell* findCell(LocalCoords* coords, std::map<int, Universe*> universes);
+  Cell* findCell(LocalCoords* coords, std::map<int, Universe*>& universes);
   double minSurfaceDist(Point* point, double angle);
   std::string toString();
   void printString();
@@ -50,6 +50,11 @@ VectorizedSolver::~VectorizedSolver() {
     _scalar_flux = NULL;
   }
 
+  if (_thread_flux != NULL) {
+    MM_FREE(_thread_flux);
+    _thread_flux = NULL;
+  }
+
   if (_fission_sources != NULL) {
     MM_FREE(_fission_sources);
     _fission_sources = NULL;
@@ -172,8 +177,23 @@ void VectorizedSolver::initializeFluxArrays() {
   if (_thread_taus != NULL)
     MM_FREE(_thread_taus);
 
+  if (_thread_flux != NULL) {
+    MM_FREE(_thread_flux);
+    _thread_flux = NULL;
+  }
+
   int size;
 
+  if (_single_boundary_flux)
+    log_printf(WARNING, "The VectorizedSolver stores the boundary fluxes "
+               "in FP_PRECISION since its sweep is not implemented for "
+               "single precision boundary fluxes");
+
+  if (_adaptive_precision)
+    log_printf(WARNING, "The VectorizedSolver does not use adaptive "
+               "precision since its boundary fluxes are stored in "
+               "FP_PRECISION");
+
   /* Allocate aligned memory for all flux arrays */
   try{
 
@@ -188,6 +208,10 @@ void VectorizedSolver::initializeFluxArrays() {
     size = _num_threads * _polar_times_groups * sizeof(FP_PRECISION);
     _thread_taus = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
 
+    if (_flux_tally_type == THREAD_PRIVATE) {
+      size = _num_threads * _num_FSRs * _num_groups * sizeof(FP_PRECISION);
+      _thread_flux = (FP_PRECISION*)MM_MALLOC(size, VEC_ALIGNMENT);
+    }
   }
   catch(std::exception &e) {
     log_printf(ERROR, "Could not allocate memory for the VectorizedSolver's "
@@ -245,6 +269,22 @@ void VectorizedSolver::initializeSourceArrays() {
 }
 
 
+/**
+ * @brief Selects the Track sweep which inlines the vectorized
+ *        VectorizedSolver::scalarFluxTally() and
+ *        VectorizedSolver::transferBoundaryFlux() routines.
+ */
+void VectorizedSolver::initializeSweepKernels() {
+
+  _sweep_track = &VectorizedSolver::sweepTrack<VectorizedSolver>;
+
+  if (_energy_sweep_type == ENERGY_GAUSS_SEIDEL)
+    log_printf(WARNING, "The VectorizedSolver sweeps all energy groups "
+               "together since the Gauss-Seidel energy sweep is not "
+               "vectorized");
+}
+
+
 /**
  * @brief Normalizes all FSR scalar fluxes and Track boundary angular
  *        fluxes to the total fission source (times \f$ \nu \f$).
@@ -332,6 +372,8 @@ FP_PRECISION VectorizedSolver::computeFSRSources() {
   FP_PRECISION* sigma_s;
   FP_PRECISION* sigma_t;
   FP_PRECISION* chi;
+  int* sigma_s_begin;
+  int* sigma_s_end;
   Material* material;
 
   FP_PRECISION source_residual = 0.0;
@@ -340,7 +382,8 @@ FP_PRECISION VectorizedSolver::computeFSRSources() {
 
   /* For all FSRs, find the source */
   #pragma omp parallel for private(material, nu_sigma_f, chi, \
-    sigma_s, sigma_t, fission_source, scatter_source) schedule(guided)
+    sigma_s, sigma_t, sigma_s_begin, sigma_s_end, fission_source, \
+    scatter_source) schedule(guided)
   for (int r=0; r < _num_FSRs; r++) {
 
     tid = omp_get_thread_num();
@@ -349,6 +392,8 @@ FP_PRECISION VectorizedSolver::computeFSRSources() {
     chi = material->getChi();
     sigma_s = material->getSigmaS();
     sigma_t = material->getSigmaT();
+    sigma_s_begin = material->getSigmaSBegin();
+    sigma_s_end = material->getSigmaSEnd();
 
     /* Initialize the source residual to zero */
     _source_residuals[r] = 0.;
@@ -375,11 +420,15 @@ FP_PRECISION VectorizedSolver::computeFSRSources() {
     else
       fission_source = 0.0;
 
-    /* Compute total scattering source for group G */
+    /* Compute total scattering source for group G from only those
+     * vector widths which overlap the band of non-zero cross-sections */
     for (int G=0; G < _num_groups; G++) {
       scatter_source = 0;
 
-      for (int v=0; v < _num_vector_lengths; v++) {
+      int v_begin = sigma_s_begin[G] / VEC_LENGTH;
+      int v_end = (sigma_s_end[G] + VEC_LENGTH - 1) / VEC_LENGTH;
+
+      for (int v=v_begin; v < v_end; v++) {
 
         #pragma simd vectorlength(VEC_LENGTH)
         for (int g=v*VEC_LENGTH; g < (v+1)*VEC_LENGTH; g++)
@@ -387,11 +436,18 @@ FP_PRECISION VectorizedSolver::computeFSRSources() {
                                     _scalar_flux(r,g);
       }
 
-      #ifdef SINGLE
-      scatter_source=cblas_sasum(_num_groups,&_scatter_sources(tid,0),1);
-      #else
-      scatter_source=cblas_dasum(_num_groups,&_scatter_sources(tid,0),1);
-      #endif
+      int g_begin = v_begin * VEC_LENGTH;
+      int g_end = std::min(v_end * VEC_LENGTH, _num_groups);
+
+      if (g_end > g_begin) {
+        #ifdef SINGLE
+        scatter_source = cblas_sasum(g_end - g_begin,
+                                     &_scatter_sources(tid,g_begin), 1);
+        #else
+        scatter_source = cblas_dasum(g_end - g_begin,
+                                     &_scatter_sources(tid,g_begin), 1);
+        #endif
+      }
 
       /* Set the total source for FSR r in group G */
       _source(r,G) = (fission_source * chi[G] + scatter_source)
@@ -576,28 +632,26 @@ return;
  * @details This method integrates the angular flux for a Track segment across
  *        energy groups and polar angles, and tallies it into the FSR scalar
  *        flux, and updates the Track's angular flux.
- * @param curr_segment a pointer to the Track segment of interest
+ * @param segment_id the index of the Track segment in the segment arrays
  * @param azim_index a pointer to the azimuthal angle index for this segment
  * @param track_flux a pointer to the Track's angular flux
  * @param fsr_flux a pointer to the temporary FSR flux buffer
  * @param fwd
  */
-void VectorizedSolver::scalarFluxTally(segment* curr_segment,
+void VectorizedSolver::scalarFluxTally(int segment_id,
                                        int azim_index,
                                        FP_PRECISION* track_flux,
                                        FP_PRECISION* fsr_flux,
                                        bool fwd){
 
   int tid = omp_get_thread_num();
-  int fsr_id = curr_segment->_region_id;
-  FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  int fsr_id = _segment_FSR_ids[segment_id];
 
   /* The change in angular flux along this Track segment in the FSR */
   FP_PRECISION delta_psi;
   FP_PRECISION* exponentials = &_thread_exponentials[tid*_polar_times_groups];
 
-  computeExponentials(curr_segment, exponentials);
+  computeExponentials(segment_id, exponentials);
 
   /* Set the FSR scalar flux buffer to zero */
   memset(fsr_flux, 0.0, _num_groups * sizeof(FP_PRECISION));
@@ -620,9 +674,20 @@ void VectorizedSolver::scalarFluxTally(segment* curr_segment,
     }
   }
 
-  /* Atomically increment the FSR scalar flux from the temporary array */
-  omp_set_lock(&_FSR_locks[fsr_id]);
-  {
+  /* Increment this thread's private FSR scalar flux without locks */
+  if (_flux_tally_type == THREAD_PRIVATE) {
+    #ifdef SINGLE
+    vsAdd(_num_groups, &_thread_flux(tid,fsr_id,0), fsr_flux,
+          &_thread_flux(tid,fsr_id,0));
+    #else
+    vdAdd(_num_groups, &_thread_flux(tid,fsr_id,0), fsr_flux,
+          &_thread_flux(tid,fsr_id,0));
+    #endif
+  }
+
+  /* Increment the FSR scalar flux without locks since no other Track of
+   * this color crosses this FSR */
+  else if (_flux_tally_type == TRACK_COLORING) {
     #ifdef SINGLE
     vsAdd(_num_groups, &_scalar_flux(fsr_id,0), fsr_flux,
           &_scalar_flux(fsr_id,0));
@@ -631,7 +696,21 @@ void VectorizedSolver::scalarFluxTally(segment* curr_segment,
           &_scalar_flux(fsr_id,0));
     #endif
   }
-  omp_unset_lock(&_FSR_locks[fsr_id]);
+
+  /* Atomically increment the FSR scalar flux from the temporary array */
+  else {
+    setFSRLock(fsr_id);
+    {
+      #ifdef SINGLE
+      vsAdd(_num_groups, &_scalar_flux(fsr_id,0), fsr_flux,
+            &_scalar_flux(fsr_id,0));
+      #else
+      vdAdd(_num_groups, &_scalar_flux(fsr_id,0), fsr_flux,
+            &_scalar_flux(fsr_id,0));
+      #endif
+    }
+    omp_unset_lock(&_FSR_locks[fsr_id]);
+  }
 
   return;
 }
@@ -641,28 +720,42 @@ void VectorizedSolver::scalarFluxTally(segment* curr_segment,
  * @brief Computes an array of the exponentials in the transport equation,
  *        \f$ exp(-\frac{\Sigma_t * l}{sin(\theta)}) \f$, for each energy group
  *        and polar angle for a given Track segment.
- * @param curr_segment pointer to the Track segment of interest
+ * @param segment_id the index of the Track segment in the segment arrays
  * @param exponentials the array to store the exponential values
  */
-void VectorizedSolver::computeExponentials(segment* curr_segment,
+void VectorizedSolver::computeExponentials(int segment_id,
                                            FP_PRECISION* exponentials) {
 
-  FP_PRECISION length = curr_segment->_length;
-  FP_PRECISION* sigma_t = curr_segment->_material->getSigmaT();
+  FP_PRECISION length = _segment_lengths[segment_id];
+  FP_PRECISION* sigma_t =
+      _materials[_segment_material_uids[segment_id]]->getSigmaT();
+
+  /* Copy the stored exponentials */
+  if (_segment_exponentials != NULL)
+    memcpy(exponentials,
+           &_segment_exponentials[size_t(segment_id) * _polar_times_groups],
+           _polar_times_groups * sizeof(FP_PRECISION));
+
+  else if (_segment_exponentials_single != NULL) {
+    float* stored = &_segment_exponentials_single[size_t(segment_id) *
+                                                  _polar_times_groups];
+    #pragma simd
+    for (int i=0; i < _polar_times_groups; i++)
+      exponentials[i] = stored[i];
+  }
 
   /* Evaluate the exponentials using the linear interpolation table */
-  if (_interpolate_exponential) {
-    FP_PRECISION tau;
+  else if (_interpolate_exponential) {
+    FP_PRECISION tau, delta;
     int index;
 
     for (int e=0; e < _num_groups; e++) {
-      for (int p=0; p < _num_polar; p++) {
-        tau = sigma_t[e] * length;
-        index = round_to_int(tau * _inverse_exp_table_spacing);
-        index *= _two_times_num_polar;
-        exponentials(p,e) = (1. - (_exp_table[index+2 * p] * tau +
-                             _exp_table[index + 2 * p +1]));
-      }
+      tau = std::min(sigma_t[e] * length, _exp_table_max_tau);
+      index = round_to_int(tau * _inverse_exp_table_spacing);
+      delta = tau - index * _exp_table_spacing;
+
+      for (int p=0; p < _num_polar; p++)
+        exponentials(p,e) = interpolateExponential(index, p, delta);
     }
   }
 
@@ -38,6 +38,9 @@
  */
 class VectorizedSolver : public CPUSolver {
 
+  /* The CPUSolver's templated Track sweep calls the per-segment routines */
+  friend class CPUSolver;
+
 protected:
 
   /** Number of energy groups divided by vector widths (VEC_LENGTH) */
@@ -53,10 +56,11 @@ protected:
   void buildExpInterpTable();
   void initializeFluxArrays();
   void initializeSourceArrays();
+  void initializeSweepKernels();
 
   void normalizeFluxes();
   FP_PRECISION computeFSRSources();
-  void scalarFluxTally(segment* curr_segment, int azim_index,
+  void scalarFluxTally(int segment_id, int azim_index,
                        FP_PRECISION* track_flux,
                        FP_PRECISION* fsr_flux, bool fwd);
   void transferBoundaryFlux(int track_id, int azim_index, bool direction,
@@ -69,10 +73,10 @@ protected:
    * @brief Computes an array of the exponentials in the transport equation,
    *        \f$ exp(-\frac{\Sigma_t * l}{sin(\theta)}) \f$, for each
    *        energy group and polar angle for a given segment.
-   * @param curr_segment pointer to the segment of interest
+   * @param segment_id the index of the segment in the segment arrays
    * @param exponentials the array to store the exponential values
    */
-  virtual void computeExponentials(segment* curr_segment,
+  void computeExponentials(int segment_id,
                                    FP_PRECISION* exponentials);
 
 public:
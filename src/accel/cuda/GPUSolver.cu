@@ -1067,10 +1067,7 @@ void GPUSolver::initializeFSRs() {
     /* Initialize each FSRs volume to 0 to avoid NaNs */
     memset(temp_FSR_volumes, FP_PRECISION(0.), _num_FSRs*sizeof(FP_PRECISION));
 
-    Track* track;
-    int num_segments;
-    segment* curr_segment;
-    segment* segments;
+    int uid;
     FP_PRECISION volume;
 
     FP_PRECISION* azim_weights = _track_generator->getAzimWeights();
@@ -1080,15 +1077,12 @@ void GPUSolver::initializeFSRs() {
     for (int i=0; i < _num_azim; i++) {
       for (int j=0; j < _num_tracks[i]; j++) {
 
-        track = &_track_generator->getTracks()[i][j];
-        num_segments = track->getNumSegments();
-        segments = track->getSegments();
+        uid = _track_generator->getTracks()[i][j].getUid();
 
         /* Iterate over the Track's segments to update FSR volumes */
-        for (int s = 0; s < num_segments; s++) {
-          curr_segment = &segments[s];
-          volume = curr_segment->_length * azim_weights[i];
-          temp_FSR_volumes[curr_segment->_region_id] += volume;
+        for (int s=_segment_offsets[uid]; s < _segment_offsets[uid+1]; s++) {
+          volume = _segment_lengths[s] * azim_weights[i];
+          temp_FSR_volumes[_segment_FSR_ids[s]] += volume;
         }
       }
     }
@@ -1170,7 +1164,7 @@ void GPUSolver::initializeTracks() {
 
     for (int i=0; i < _tot_num_tracks; i++) {
 
-      clone_track_on_gpu(_tracks[i], &_dev_tracks[i]);
+      clone_track_on_gpu(_tracks[i], &_dev_tracks[i], _track_generator);
 
       /* Make Track reflective */
       index = computeScalarTrackIndex(_tracks[i]->getTrackInI(),
@@ -1590,6 +1584,80 @@ void GPUSolver::addSourceToScalarFlux() {
 }
 
 
+/**
+ * @brief Accelerates the FSR scalar fluxes and Track boundary angular fluxes
+ *        computed by a transport sweep on the GPU.
+ * @details The fluxes are copied to the host for Solver::andersonMix(...)
+ *          and the mixed fluxes are copied back to the device.
+ */
+void GPUSolver::accelerateFluxes() {
+
+  if (_anderson_fluxes == NULL)
+    return;
+
+  int num_scalar_fluxes = _num_FSRs * _num_groups;
+  int num_boundary_fluxes = 2 * _tot_num_tracks * _polar_times_groups;
+
+  FP_PRECISION* scalar_flux = new FP_PRECISION[num_scalar_fluxes];
+  FP_PRECISION* boundary_flux = new FP_PRECISION[num_boundary_fluxes];
+
+  cudaMemcpy((void*)scalar_flux, (void*)_scalar_flux,
+             num_scalar_fluxes * sizeof(FP_PRECISION),
+             cudaMemcpyDeviceToHost);
+  cudaMemcpy((void*)boundary_flux, (void*)_boundary_flux,
+             num_boundary_fluxes * sizeof(FP_PRECISION),
+             cudaMemcpyDeviceToHost);
+
+  andersonMix(scalar_flux, boundary_flux);
+
+  cudaMemcpy((void*)_scalar_flux, (void*)scalar_flux,
+             num_scalar_fluxes * sizeof(FP_PRECISION),
+             cudaMemcpyHostToDevice);
+  cudaMemcpy((void*)_boundary_flux, (void*)boundary_flux,
+             num_boundary_fluxes * sizeof(FP_PRECISION),
+             cudaMemcpyHostToDevice);
+
+  delete [] scalar_flux;
+  delete [] boundary_flux;
+}
+
+
+/**
+ * @brief Copies the FSR scalar fluxes followed by the Track boundary angular
+ *        fluxes from the device into an array on the host.
+ * @param fluxes the array to store the fluxes
+ */
+void GPUSolver::getFluxes(FP_PRECISION* fluxes) {
+
+  int num_scalar_fluxes = _num_FSRs * _num_groups;
+
+  cudaMemcpy((void*)fluxes, (void*)_scalar_flux,
+             num_scalar_fluxes * sizeof(FP_PRECISION),
+             cudaMemcpyDeviceToHost);
+  cudaMemcpy((void*)&fluxes[num_scalar_fluxes], (void*)_boundary_flux,
+             2 * _tot_num_tracks * _polar_times_groups * sizeof(FP_PRECISION),
+             cudaMemcpyDeviceToHost);
+}
+
+
+/**
+ * @brief Copies the FSR scalar fluxes and Track boundary angular fluxes
+ *        from an array on the host to the device.
+ * @param fluxes the FSR scalar fluxes followed by the boundary fluxes
+ */
+void GPUSolver::setFluxes(FP_PRECISION* fluxes) {
+
+  int num_scalar_fluxes = _num_FSRs * _num_groups;
+
+  cudaMemcpy((void*)_scalar_flux, (void*)fluxes,
+             num_scalar_fluxes * sizeof(FP_PRECISION),
+             cudaMemcpyHostToDevice);
+  cudaMemcpy((void*)_boundary_flux, (void*)&fluxes[num_scalar_fluxes],
+             2 * _tot_num_tracks * _polar_times_groups * sizeof(FP_PRECISION),
+             cudaMemcpyHostToDevice);
+}
+
+
 /**
  * @brief Compute \f$ k_{eff} \f$ from the total fission and absorption rates.
  * @details This method computes the current approximation to the
@@ -122,6 +122,9 @@ private:
   void addSourceToScalarFlux();
   void computeKeff();
   void transportSweep();
+  void accelerateFluxes();
+  void getFluxes(FP_PRECISION* fluxes);
+  void setFluxes(FP_PRECISION* fluxes);
   //void updateBoundaryFlux();
   
 
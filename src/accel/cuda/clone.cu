@@ -78,34 +78,44 @@ void clone_material_on_gpu(Material* material_h, dev_material* material_d) {
  *        private class method and is not intended to be called
  *        directly.  @param track_h pointer to a Track on the host
  *        @param track_d pointer to a dev_track on the GPU
+ *        @param track_generator pointer to the TrackGenerator which
+ *        stores the Track's segments
  */
-void clone_track_on_gpu(Track* track_h, dev_track* track_d) {
+void clone_track_on_gpu(Track* track_h, dev_track* track_d,
+                        TrackGenerator* track_generator) {
+
+  int uid = track_h->getUid();
+  int* segment_offsets = track_generator->getSegmentOffsets();
+  int min_segment = segment_offsets[uid];
+  int num_segments = segment_offsets[uid+1] - min_segment;
+
+  FP_PRECISION* lengths = track_generator->getSegmentLengths();
+  int* FSR_ids = track_generator->getSegmentFSRIds();
+  int* material_uids = track_generator->getSegmentMaterialUids();
 
   dev_segment* dev_segments;
-  dev_segment* host_segments = new dev_segment[track_h->getNumSegments()];
+  dev_segment* host_segments = new dev_segment[num_segments];
   dev_track new_track;
 
-  new_track._uid = track_h->getUid();
-  new_track._num_segments = track_h->getNumSegments();
+  new_track._uid = uid;
+  new_track._num_segments = num_segments;
   new_track._azim_angle_index = track_h->getAzimAngleIndex();
   new_track._refl_in = track_h->isReflIn();
   new_track._refl_out = track_h->isReflOut();
   new_track._bc_in = track_h->getBCIn();
   new_track._bc_out = track_h->getBCOut();
 
-  cudaMalloc((void**)&dev_segments,
-             track_h->getNumSegments() * sizeof(dev_segment));
+  cudaMalloc((void**)&dev_segments, num_segments * sizeof(dev_segment));
   new_track._segments = dev_segments;
 
-  for (int s=0; s < track_h->getNumSegments(); s++) {
-    segment* curr = track_h->getSegment(s);
-    host_segments[s]._length = curr->_length;
-    host_segments[s]._region_uid = curr->_region_id;
-    host_segments[s]._material_uid = curr->_material->getUid();
+  for (int s=0; s < num_segments; s++) {
+    host_segments[s]._length = lengths[min_segment+s];
+    host_segments[s]._region_uid = FSR_ids[min_segment+s];
+    host_segments[s]._material_uid = material_uids[min_segment+s];
   }
 
   cudaMemcpy((void*)dev_segments, (void*)host_segments,
-             track_h->getNumSegments() * sizeof(dev_segment),
+             num_segments * sizeof(dev_segment),
              cudaMemcpyHostToDevice);
   cudaMemcpy((void*)track_d, (void*)&new_track, sizeof(dev_track),
              cudaMemcpyHostToDevice);
@@ -8,6 +8,8 @@
 
 #include "../DeviceMaterial.h"
 #include "../DeviceTrack.h"
+#include "../../TrackGenerator.h"
 
 void clone_material_on_gpu(Material* material_h, dev_material* material_d);
-void clone_track_on_gpu(Track* track_h, dev_track* track_d);
+void clone_track_on_gpu(Track* track_h, dev_track* track_d,
+                        TrackGenerator* track_generator);
@@ -424,42 +424,46 @@ void log_printf(logLevel level, const char* format, ...) {
       }
     }
 
-    /* If this is our first time logging, add a header with date, time */
-    if (!logging) {
-
-      /* If output directory was not defined by user, then log file is
-       * written to a "log" subdirectory. Create it if it doesn't exist */
-      if (output_directory.compare(".") == 0) {
-        struct stat st;
-        if (!stat("log", &st) == 0)
-          mkdir("log", S_IRWXU);
+    /* Write the message from one thread at a time */
+    #pragma omp critical (log)
+    {
+      /* If this is our first time logging, add a header with date, time */
+      if (!logging) {
+
+        /* If output directory was not defined by user, then log file is
+         * written to a "log" subdirectory. Create it if it doesn't exist */
+        if (output_directory.compare(".") == 0) {
+          struct stat st;
+          if (!stat("log", &st) == 0)
+            mkdir("log", S_IRWXU);
+        }
+
+        /* Write the message to the output file */
+        std::ofstream log_file;
+        log_file.open((output_directory + "/" + log_filename).c_str(),
+                     std::ios::app);
+
+        /* Append date, time to the top of log output file */
+        time_t rawtime;
+        struct tm * timeinfo;
+        time (&rawtime);
+        timeinfo = localtime (&rawtime);
+        log_file << "Current local time and date: " << asctime(timeinfo);
+        logging = true;
+
+        log_file.close();
       }
 
-      /* Write the message to the output file */
+      /* Write the log message to the log_file */
       std::ofstream log_file;
       log_file.open((output_directory + "/" + log_filename).c_str(),
-                   std::ios::app);
-
-      /* Append date, time to the top of log output file */
-      time_t rawtime;
-      struct tm * timeinfo;
-      time (&rawtime);
-      timeinfo = localtime (&rawtime);
-      log_file << "Current local time and date: " << asctime(timeinfo);
-      logging = true;
-
+                    std::ios::app);
+      log_file << msg_string;
       log_file.close();
-    }
 
-    /* Write the log message to the log_file */
-    std::ofstream log_file;
-    log_file.open((output_directory + "/" + log_filename).c_str(),
-                  std::ios::app);
-    log_file << msg_string;
-    log_file.close();
-
-    /* Write the log message to the shell */
-    std::cout << msg_string;
+      /* Write the log message to the shell */
+      std::cout << msg_string;
+    }
   }
 
 